@@ -7,10 +7,44 @@ DO NOT MODIFY THIS FILE. This file will be used for ArrayBag interface throughou
 
 /** default constructor**/
 template<class ItemType>
-ArrayBag<ItemType>::ArrayBag(): item_count_(0)
+ArrayBag<ItemType>::ArrayBag(): items_(new ItemType[DEFAULT_CAPACITY]), item_count_(0)
 {
 }  // end default constructor
 
+/** copy constructor: copies every item of a_bag **/
+template<class ItemType>
+ArrayBag<ItemType>::ArrayBag(const ArrayBag<ItemType>& a_bag): ArrayBag()
+{
+	for (int i = 0; i < a_bag.item_count_; i++)
+	{
+		items_[i] = a_bag.items_[i];
+	}  // end for
+	item_count_ = a_bag.item_count_;
+}  // end copy constructor
+
+/** move constructor: takes the items of a_bag in O(1), leaving it empty **/
+template<class ItemType>
+ArrayBag<ItemType>::ArrayBag(ArrayBag<ItemType>&& a_bag) noexcept: items_(std::move(a_bag.items_)), item_count_(a_bag.item_count_)
+{
+	a_bag.item_count_ = 0;
+}  // end move constructor
+
+/** copy-and-swap assignment; a_bag is a copy, or the moved-from bag when assigning an rvalue **/
+template<class ItemType>
+ArrayBag<ItemType>& ArrayBag<ItemType>::operator=(ArrayBag<ItemType> a_bag)
+{
+	swap(a_bag);
+	return *this;
+}  // end operator=
+
+/** @post this bag and a_bag have exchanged their items, in O(1) **/
+template<class ItemType>
+void ArrayBag<ItemType>::swap(ArrayBag<ItemType>& a_bag) noexcept
+{
+	items_.swap(a_bag.items_);
+	std::swap(item_count_, a_bag.item_count_);
+}  // end swap
+
 /**
  @return item_count_ : the current size of the bag
  **/
@@ -41,6 +75,10 @@ bool ArrayBag<ItemType>::add(const ItemType& new_entry)
 	bool has_room = (item_count_ < DEFAULT_CAPACITY);
 	if (has_room)
 	{
+		if (!items_)
+		{
+			items_.reset(new ItemType[DEFAULT_CAPACITY]); // Storage was moved away
+		}  // end if
 		items_[item_count_] = new_entry;
 		item_count_++;
         return true;
@@ -49,6 +87,42 @@ bool ArrayBag<ItemType>::add(const ItemType& new_entry)
 	return false;
 }  // end add
 
+/**
+ @return true if new_entry was moved into items_, false otherwise (new_entry is then unchanged)
+ **/
+template<class ItemType>
+bool ArrayBag<ItemType>::add(ItemType&& new_entry)
+{
+   if (contains(new_entry)) {
+       return false;
+   }
+	bool has_room = (item_count_ < DEFAULT_CAPACITY);
+	if (has_room)
+	{
+		if (!items_)
+		{
+			items_.reset(new ItemType[DEFAULT_CAPACITY]); // Storage was moved away
+		}  // end if
+		items_[item_count_] = std::move(new_entry);
+		item_count_++;
+        return true;
+	}  // end if
+
+	return false;
+}  // end add
+
+/**
+ @param args to construct the new entry from
+ @return true if the entry made from args was added to items_, false otherwise
+ **/
+template<class ItemType>
+template<class... Args>
+bool ArrayBag<ItemType>::emplace(Args&&... args)
+{
+	// The slots of items_ already hold constructed items, so the entry is built once and moved in
+	return add(ItemType(std::forward<Args>(args)...));
+}  // end emplace
+
 /**
  @return true if an_entry was successfully removed from items_, false otherwise
  **/
@@ -60,7 +134,7 @@ bool ArrayBag<ItemType>::remove(const ItemType& an_entry)
 	if (can_remove)
 	{
 		item_count_--;
-		items_[found_index] = items_[item_count_];
+		items_[found_index] = std::move(items_[item_count_]);
 	}  // end if
 
 	return can_remove;
@@ -5,6 +5,8 @@ DO NOT MODIFY THIS FILE. This file will be used for ArrayBag interface throughou
 #ifndef ARRAY_BAG_
 #define ARRAY_BAG_
 #include <iostream>
+#include <memory>
+#include <utility>
 #include <vector>
 
 template <class ItemType>
@@ -15,6 +17,18 @@ class ArrayBag
    /** default constructor**/
    ArrayBag();
 
+   /** copy constructor: copies every item of a_bag **/
+   ArrayBag(const ArrayBag<ItemType> &a_bag);
+
+   /** move constructor: takes the items of a_bag in O(1), leaving it empty **/
+   ArrayBag(ArrayBag<ItemType> &&a_bag) noexcept;
+
+   /** copy-and-swap assignment; a_bag is a copy, or the moved-from bag when assigning an rvalue **/
+   ArrayBag<ItemType> &operator=(ArrayBag<ItemType> a_bag);
+
+   /** @post this bag and a_bag have exchanged their items, in O(1) **/
+   void swap(ArrayBag<ItemType> &a_bag) noexcept;
+
    /**
        @return item_count_ : the current size of the bag
    **/
@@ -30,6 +44,18 @@ class ArrayBag
    **/
    bool add(const ItemType &new_entry);
 
+   /**
+       @return true if new_entry was moved into items_, false otherwise (new_entry is then unchanged)
+   **/
+   bool add(ItemType &&new_entry);
+
+   /**
+       @param args to construct the new entry from
+       @return true if the entry made from args was added to items_, false otherwise
+   **/
+   template <class... Args>
+   bool emplace(Args &&...args);
+
    /**
        @return true if an_entry was successfully removed from items_, false otherwise
       **/
@@ -52,7 +78,7 @@ class ArrayBag
 
    protected:
    static const int DEFAULT_CAPACITY = 100; //max size of items_ at 100 by default for this project
-   ItemType items_[DEFAULT_CAPACITY];      // Array of bag items
+   std::unique_ptr<ItemType[]> items_;     // Array of bag items, on the heap so that a move is O(1); nullptr after a move
    int item_count_;                        // Current count of bag items
 
    /**
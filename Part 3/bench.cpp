@@ -0,0 +1,100 @@
+// bench.cpp drives Kitchen with a generated order stream and prints throughput and latency percentiles.
+// Usage: ./bench [orders] [seed]   (without arguments it sweeps 10^3 to 10^6 orders)
+
+#include "Kitchen.hpp"
+#include "../part 4/WorkloadGenerator.hpp"
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+Dish makeDish(const DishSpec& spec) {
+    std::vector<std::string> ingredients;
+    for (const IngredientSpec& ingredient : spec.ingredients) {
+        ingredients.push_back(ingredient.name);
+    }
+    return Dish(spec.name, ingredients, spec.prep_time, spec.price, static_cast<Dish::CuisineType>(spec.cuisine));
+}
+
+void runScale(int num_orders, unsigned seed) {
+    WorkloadConfig config;
+    config.seed = seed;
+    config.num_orders = num_orders;
+    config.num_dishes = 500;
+    Workload workload = WorkloadGenerator(config).generate();
+
+    std::vector<Dish> menu;
+    for (const DishSpec& spec : workload.menu) {
+        menu.push_back(makeDish(spec));
+    }
+
+    std::cout << "== " << num_orders << " orders, " << menu.size() << " dishes (seed " << seed << ") ==" << std::endl;
+
+    // A Kitchen holds at most 100 dishes, so the stream is treated as a FIFO pass: an order that is already
+    // in the kitchen is served, otherwise it is added, serving the oldest dish first when the kitchen is full.
+    Kitchen* kitchen = new Kitchen();
+    std::deque<int> in_kitchen;
+    LatencyRecorder new_orders;
+    LatencyRecorder served;
+    LatencyRecorder reports;
+    uint64_t new_order_total = 0;
+    uint64_t served_total = 0;
+    uint64_t report_total = 0;
+    long checksum = 0;
+
+    for (const OrderSpec& order : workload.orders) {
+        const Dish& dish = menu[order.dish_id];
+        if (kitchen->contains(dish)) {
+            auto start = LatencyRecorder::Clock::now();
+            kitchen->serveDish(dish);
+            uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+            served.record(spent);
+            served_total += spent;
+            for (auto it = in_kitchen.begin(); it != in_kitchen.end(); ++it) {
+                if (*it == order.dish_id) {
+                    in_kitchen.erase(it);
+                    break;
+                }
+            }
+            continue;
+        }
+        if (kitchen->getCurrentSize() == 100) {
+            auto start = LatencyRecorder::Clock::now();
+            kitchen->serveDish(menu[in_kitchen.front()]);
+            uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+            served.record(spent);
+            served_total += spent;
+            in_kitchen.pop_front();
+        }
+        auto start = LatencyRecorder::Clock::now();
+        kitchen->newOrder(dish);
+        uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        new_orders.record(spent);
+        new_order_total += spent;
+        in_kitchen.push_back(order.dish_id);
+
+        start = LatencyRecorder::Clock::now();
+        checksum += kitchen->calculateAvgPrepTime() + kitchen->tallyCuisineTypes(dish.getCuisineType());
+        spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        reports.record(spent);
+        report_total += spent;
+    }
+
+    new_orders.report("Kitchen::newOrder", new_order_total);
+    served.report("Kitchen::serveDish", served_total);
+    reports.report("avgPrepTime+tallyCuisine", report_total);
+    std::cout << "kitchen size " << kitchen->getCurrentSize() << " (checksum " << checksum << ")" << std::endl << std::endl;
+    delete kitchen;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 42;
+    if (argc > 1) {
+        runScale(std::stoi(argv[1]), seed);
+    } else {
+        for (int orders : {1000, 10000, 100000, 1000000}) {
+            runScale(orders, seed);
+        }
+    }
+    return 0;
+}
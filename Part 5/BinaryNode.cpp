@@ -9,19 +9,24 @@
 
 template<class T>
 BinaryNode<T>::BinaryNode()
-      : item(nullptr), leftChildPtr(nullptr), rightChildPtr(nullptr)
+      : item(nullptr), leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
 { }  // end default constructor
 
 template<class T>
 BinaryNode<T>::BinaryNode(const T& anItem)
-      : item(anItem), leftChildPtr(nullptr), rightChildPtr(nullptr)
+      : item(anItem), leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
+{ }  // end constructor
+
+template<class T>
+BinaryNode<T>::BinaryNode(T&& anItem)
+      : item(std::move(anItem)), leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
 { }  // end constructor
 
 template<class T>
 BinaryNode<T>::BinaryNode(const T& anItem,
                                     std::shared_ptr<BinaryNode<T>> leftPtr,
                                     std::shared_ptr<BinaryNode<T>> rightPtr)
-      : item(anItem), leftChildPtr(leftPtr), rightChildPtr(rightPtr)
+      : item(anItem), leftChildPtr(leftPtr), rightChildPtr(rightPtr), height(1)
 { }  // end constructor
 
 template<class T>
@@ -42,6 +47,18 @@ bool BinaryNode<T>::isLeaf() const
    return ((leftChildPtr == nullptr) && (rightChildPtr == nullptr));
 }
 
+template<class T>
+int BinaryNode<T>::getHeight() const
+{
+   return height;
+}  // end getHeight
+
+template<class T>
+void BinaryNode<T>::setHeight(int newHeight)
+{
+   height = newHeight;
+}  // end setHeight
+
 template<class T>
 void BinaryNode<T>::setLeftChildPtr(std::shared_ptr<BinaryNode<T>> leftPtr)
 {
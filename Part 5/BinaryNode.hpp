@@ -10,6 +10,7 @@
 #define BINARY_NODE_
 
 #include <memory>
+#include <utility>
 
 template<class T>
 class BinaryNode
@@ -18,10 +19,12 @@ private:
    T item;           // Data portion
    std::shared_ptr<BinaryNode<T>> leftChildPtr;   // Pointer to left child
    std::shared_ptr<BinaryNode<T>> rightChildPtr;  // Pointer to right child
+   int height;       // Nodes on the longest path down to a leaf; kept up to date by a self-balancing tree
 
 public:
    BinaryNode();
    BinaryNode(const T& anItem);
+   BinaryNode(T&& anItem);
    BinaryNode(const T& anItem, std::shared_ptr<BinaryNode<T>> leftPtr, std::shared_ptr<BinaryNode<T>> rightPtr);
 
    void setItem(const T& anItem);
@@ -29,6 +32,9 @@ public:
    
    bool isLeaf() const;
 
+   int getHeight() const;
+   void setHeight(int newHeight);
+
    std::shared_ptr<BinaryNode<T>> getLeftChildPtr() const;
    std::shared_ptr<BinaryNode<T>> getRightChildPtr() const;
    
@@ -5,22 +5,44 @@
 /*CONSTRUCTRS*/
 
 template <class T>
-BinarySearchTree<T>::BinarySearchTree() : root_ptr_(nullptr)
+BinarySearchTree<T>::BinarySearchTree() : root_ptr_(nullptr), self_balancing_(false)
 {
 } // end default constructor
 
 template <class T>
 BinarySearchTree<T>::BinarySearchTree(const T &root_item)
-    : root_ptr_(std::make_shared<BinaryNode<T>>(root_item, nullptr, nullptr))
+    : root_ptr_(std::make_shared<BinaryNode<T>>(root_item, nullptr, nullptr)), self_balancing_(false)
 {
 } // end constructor
 
 template <class T>
 BinarySearchTree<T>::BinarySearchTree(const BinarySearchTree &another_tree)
+    : self_balancing_(another_tree.self_balancing_)
 {
   root_ptr_ = copyTree(another_tree.root_ptr_); // Call helper method
 } // end copy constructor
 
+template <class T>
+BinarySearchTree<T>::BinarySearchTree(BinarySearchTree &&another_tree) noexcept
+    : root_ptr_(std::move(another_tree.root_ptr_)), self_balancing_(another_tree.self_balancing_)
+{
+} // end move constructor
+
+template <class T>
+BinarySearchTree<T> &BinarySearchTree<T>::operator=(BinarySearchTree another_tree)
+{
+  swap(another_tree);
+  return *this;
+} // end operator=
+
+/** @post this tree and another_tree have exchanged their nodes, in O(1) **/
+template <class T>
+void BinarySearchTree<T>::swap(BinarySearchTree &another_tree) noexcept
+{
+  root_ptr_.swap(another_tree.root_ptr_);
+  std::swap(self_balancing_, another_tree.self_balancing_);
+} // end swap
+
 
 
 /*PUBLIC METHODS*/
@@ -44,6 +66,8 @@ bool BinarySearchTree<T>::isEmpty() const
 template <class T>
 int BinarySearchTree<T>::getHeight() const
 {
+  if (self_balancing_)
+    return heightOf(root_ptr_); // Kept in the root
   return this->getHeightHelper(root_ptr_); // Call helper method
 } // end getHeight
 
@@ -70,6 +94,24 @@ void BinarySearchTree<T>::add(const T &new_entry)
   root_ptr_ = placeNode(root_ptr_, new_node_ptr);
 } // end add
 
+/** @param a new entry to be moved into the BST
+    @post as add(const T&), without copying the entry **/
+template <class T>
+void BinarySearchTree<T>::add(T &&new_entry)
+{
+  std::shared_ptr<BinaryNode<T>> new_node_ptr = std::make_shared<BinaryNode<T>>(std::move(new_entry));
+  root_ptr_ = placeNode(root_ptr_, new_node_ptr);
+} // end add
+
+/** @param args to construct the new entry from
+    @post the entry made from args is added to the BST as by add **/
+template <class T>
+template <class... Args>
+void BinarySearchTree<T>::emplace(Args &&...args)
+{
+  add(T(std::forward<Args>(args)...));
+} // end emplace
+
 
   /** @param entry to be removed from the BST
       @post entry is removed from the BST and retaining its
@@ -108,9 +150,27 @@ void BinarySearchTree<T>::displayPreorder()
 template <class T>
 void BinarySearchTree<T>::setRoot(std::shared_ptr<BinaryNode<T>> new_root_ptr)
 {
-  root_ptr_ = new_root_ptr;
+  // A tree built elsewhere carries no heights, so a self-balancing tree relinks it
+  root_ptr_ = self_balancing_ ? relinkBalanced(new_root_ptr) : new_root_ptr;
 }
 
+/** @param enabled true to keep the tree an AVL tree, false to place nodes as they come
+    @post if enabled, the current tree is relinked balanced in O(n) **/
+template <class T>
+void BinarySearchTree<T>::setSelfBalancing(bool enabled)
+{
+  if (enabled && !self_balancing_)
+    root_ptr_ = relinkBalanced(root_ptr_);
+  self_balancing_ = enabled;
+} // end setSelfBalancing
+
+/** @return true if add and remove keep the tree balanced **/
+template <class T>
+bool BinarySearchTree<T>::isSelfBalancing() const
+{
+  return self_balancing_;
+} // end isSelfBalancing
+
 
 
 
@@ -146,6 +206,7 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::copyTree(const std::shared_p
   {
     // Copy node
     new_tree_ptr = std::make_shared<BinaryNode<T>>(old_tee_root_ptr->getItem(), nullptr, nullptr);
+    new_tree_ptr->setHeight(old_tee_root_ptr->getHeight());
     new_tree_ptr->setLeftChildPtr(copyTree(old_tee_root_ptr->getLeftChildPtr()));
     new_tree_ptr->setRightChildPtr(copyTree(old_tee_root_ptr->getRightChildPtr()));
   } // end if
@@ -199,7 +260,7 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::placeNode(std::shared_ptr<Bi
       subtree_ptr->setLeftChildPtr(placeNode(subtree_ptr->getLeftChildPtr(), new_node_ptr));
     else
       subtree_ptr->setRightChildPtr(placeNode(subtree_ptr->getRightChildPtr(), new_node_ptr));
-    return subtree_ptr;
+    return rebalance(subtree_ptr);
   }
 } // end placeNode
 
@@ -243,7 +304,7 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeLeftmostNode(std::shar
   else
   {
     node_ptr->setLeftChildPtr(removeLeftmostNode(node_ptr->getLeftChildPtr(), inorder_successor));
-    return node_ptr;
+    return rebalance(node_ptr);
   } // end if
 } // end removeLeftmostNode
 
@@ -279,7 +340,7 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeNode(std::shared_ptr<B
     T new_node_value;
     node_ptr->setRightChildPtr(removeLeftmostNode(node_ptr->getRightChildPtr(), new_node_value));
     node_ptr->setItem(new_node_value);
-    return node_ptr;
+    return rebalance(node_ptr);
   } // end if
 } // end removeNode
 
@@ -318,9 +379,124 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeValue(std::shared_ptr<
       // Search the right subtree
       subtree_ptr->setRightChildPtr(removeValue(subtree_ptr->getRightChildPtr(), target, success));
     }
-    return subtree_ptr;
+    return rebalance(subtree_ptr);
   }
 } // end removeValue
 
 
+/** @return the height stored in node_ptr, 0 for an empty subtree **/
+template <class T>
+int BinarySearchTree<T>::heightOf(std::shared_ptr<BinaryNode<T>> node_ptr) const
+{
+  return node_ptr == nullptr ? 0 : node_ptr->getHeight();
+} // end heightOf
+
+
+/** @post the height of node_ptr is recomputed from the heights of its children **/
+template <class T>
+void BinarySearchTree<T>::updateHeight(std::shared_ptr<BinaryNode<T>> node_ptr)
+{
+  node_ptr->setHeight(1 + std::max(heightOf(node_ptr->getLeftChildPtr()), heightOf(node_ptr->getRightChildPtr())));
+} // end updateHeight
+
+
+/** @return the new root of the subtree after its left child is rotated up into its place **/
+template <class T>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::rotateRight(std::shared_ptr<BinaryNode<T>> node_ptr)
+{
+  std::shared_ptr<BinaryNode<T>> left_ptr = node_ptr->getLeftChildPtr();
+  node_ptr->setLeftChildPtr(left_ptr->getRightChildPtr());
+  left_ptr->setRightChildPtr(node_ptr);
+  updateHeight(node_ptr);
+  updateHeight(left_ptr);
+  return left_ptr;
+} // end rotateRight
 
+
+/** @return the new root of the subtree after its right child is rotated up into its place **/
+template <class T>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::rotateLeft(std::shared_ptr<BinaryNode<T>> node_ptr)
+{
+  std::shared_ptr<BinaryNode<T>> right_ptr = node_ptr->getRightChildPtr();
+  node_ptr->setRightChildPtr(right_ptr->getLeftChildPtr());
+  right_ptr->setLeftChildPtr(node_ptr);
+  updateHeight(node_ptr);
+  updateHeight(right_ptr);
+  return right_ptr;
+} // end rotateLeft
+
+
+/** called on the way back up from placeNode and the remove helpers
+    @post if self-balancing, the height of subtree_ptr is updated and one or two rotations restore the
+          AVL property when its subtrees' heights differ by 2; otherwise nothing changes
+    @return the root of the rebalanced subtree **/
+template <class T>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::rebalance(std::shared_ptr<BinaryNode<T>> subtree_ptr)
+{
+  if (!self_balancing_)
+    return subtree_ptr;
+
+  updateHeight(subtree_ptr);
+  int balance = heightOf(subtree_ptr->getLeftChildPtr()) - heightOf(subtree_ptr->getRightChildPtr());
+  if (balance > 1)
+  {
+    // Left-heavy; a right-heavy left child is first rotated left (left-right case)
+    std::shared_ptr<BinaryNode<T>> left_ptr = subtree_ptr->getLeftChildPtr();
+    if (heightOf(left_ptr->getLeftChildPtr()) < heightOf(left_ptr->getRightChildPtr()))
+      subtree_ptr->setLeftChildPtr(rotateLeft(left_ptr));
+    return rotateRight(subtree_ptr);
+  }
+  else if (balance < -1)
+  {
+    // Right-heavy; a left-heavy right child is first rotated right (right-left case)
+    std::shared_ptr<BinaryNode<T>> right_ptr = subtree_ptr->getRightChildPtr();
+    if (heightOf(right_ptr->getRightChildPtr()) < heightOf(right_ptr->getLeftChildPtr()))
+      subtree_ptr->setRightChildPtr(rotateRight(right_ptr));
+    return rotateLeft(subtree_ptr);
+  } // end if
+  return subtree_ptr;
+} // end rebalance
+
+
+/** called by setSelfBalancing and setRoot
+    @post the nodes of the subtree are relinked, in order, into a tree of minimal height with correct heights
+    @return the root of the relinked subtree **/
+template <class T>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::relinkBalanced(std::shared_ptr<BinaryNode<T>> subtree_ptr)
+{
+  // Collect the nodes in order without recursion, since the tree may be as deep as it is large
+  std::vector<std::shared_ptr<BinaryNode<T>>> nodes;
+  std::vector<std::shared_ptr<BinaryNode<T>>> path;
+  std::shared_ptr<BinaryNode<T>> current = subtree_ptr;
+  while (current != nullptr || !path.empty())
+  {
+    while (current != nullptr)
+    {
+      path.push_back(current);
+      current = current->getLeftChildPtr();
+    }
+    current = path.back();
+    path.pop_back();
+    nodes.push_back(current);
+    current = current->getRightChildPtr();
+  } // end while
+
+  return linkRange(nodes, 0, static_cast<int>(nodes.size()) - 1);
+} // end relinkBalanced
+
+
+/** called by relinkBalanced
+    @return the root of a balanced tree of nodes[start..end] **/
+template <class T>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::linkRange(const std::vector<std::shared_ptr<BinaryNode<T>>> &nodes, int start, int end)
+{
+  if (start > end)
+    return nullptr;
+
+  int mid = start + (end - start) / 2;
+  std::shared_ptr<BinaryNode<T>> node_ptr = nodes[mid];
+  node_ptr->setLeftChildPtr(linkRange(nodes, start, mid - 1));
+  node_ptr->setRightChildPtr(linkRange(nodes, mid + 1, end));
+  updateHeight(node_ptr);
+  return node_ptr;
+} // end linkRange
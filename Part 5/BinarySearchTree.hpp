@@ -3,6 +3,7 @@
 
 #include "BinaryNode.hpp"
 #include <iostream>
+#include <vector>
 
 template <class T>
 class BinarySearchTree
@@ -12,6 +13,13 @@ public:
   BinarySearchTree();                                     //default constructor
   BinarySearchTree(const T &root_item);                   //parameterized constructor
   BinarySearchTree(const BinarySearchTree &another_tree); //copy constructor
+  BinarySearchTree(BinarySearchTree &&another_tree) noexcept; //move constructor: takes the nodes in O(1)
+
+  /** copy-and-swap assignment: another_tree is a copy, or the moved-from tree when assigning an rvalue **/
+  BinarySearchTree &operator=(BinarySearchTree another_tree);
+
+  /** @post this tree and another_tree have exchanged their nodes, in O(1) **/
+  void swap(BinarySearchTree &another_tree) noexcept;
 
   /** @return root_ptr_ **/
   std::shared_ptr<BinaryNode<T>> getRoot() const;
@@ -34,6 +42,15 @@ public:
     **/
   void add(const T &new_entry);
 
+  /** @param a new entry to be moved into the BST
+      @post as add(const T&), without copying the entry **/
+  void add(T &&new_entry);
+
+  /** @param args to construct the new entry from
+      @post the entry made from args is added to the BST as by add **/
+  template <class... Args>
+  void emplace(Args &&...args);
+
   /** @param entry to be removed from the BST
       @post entry is removed from the BST and retaining its
               BST property, s.t. at any node, all Nodes in
@@ -54,8 +71,18 @@ public:
    */
   void setRoot(std::shared_ptr<BinaryNode<T>> new_root_ptr);
 
+  /** @param enabled true to keep the tree an AVL tree: add and remove rotate nodes on the way back up so
+              the heights of the two subtrees of any node differ by at most 1, which makes add, remove and
+              contains O(log n) in the worst case; false to place nodes as they come
+      @post if enabled, the current tree (and any tree later given to setRoot) is relinked balanced in O(n) **/
+  void setSelfBalancing(bool enabled);
+
+  /** @return true if add and remove keep the tree balanced **/
+  bool isSelfBalancing() const;
+
 private:
   std::shared_ptr<BinaryNode<T>> root_ptr_;
+  bool self_balancing_;
 
   /** called by copy constructor
       @param old_tee_root_ptr a pointer to the root of the tree to be copied
@@ -117,6 +144,31 @@ private:
      **/
   std::shared_ptr<BinaryNode<T>> findNode(std::shared_ptr<BinaryNode<T>> subtree_ptr, const T &target) const;
 
+  /** @return the height stored in node_ptr, 0 for an empty subtree **/
+  int heightOf(std::shared_ptr<BinaryNode<T>> node_ptr) const;
+
+  /** @post the height of node_ptr is recomputed from the heights of its children **/
+  void updateHeight(std::shared_ptr<BinaryNode<T>> node_ptr);
+
+  /** @return the new root of the subtree after its left (right) child is rotated up into its place **/
+  std::shared_ptr<BinaryNode<T>> rotateRight(std::shared_ptr<BinaryNode<T>> node_ptr);
+  std::shared_ptr<BinaryNode<T>> rotateLeft(std::shared_ptr<BinaryNode<T>> node_ptr);
+
+  /** called on the way back up from placeNode and the remove helpers
+      @post if self-balancing, the height of subtree_ptr is updated and one or two rotations restore the
+            AVL property when its subtrees' heights differ by 2; otherwise nothing changes
+      @return the root of the rebalanced subtree **/
+  std::shared_ptr<BinaryNode<T>> rebalance(std::shared_ptr<BinaryNode<T>> subtree_ptr);
+
+  /** called by setSelfBalancing and setRoot
+      @post the nodes of the subtree are relinked, in order, into a tree of minimal height with correct heights
+      @return the root of the relinked subtree **/
+  std::shared_ptr<BinaryNode<T>> relinkBalanced(std::shared_ptr<BinaryNode<T>> subtree_ptr);
+
+  /** called by relinkBalanced
+      @return the root of a balanced tree of nodes[start..end] **/
+  std::shared_ptr<BinaryNode<T>> linkRange(const std::vector<std::shared_ptr<BinaryNode<T>>> &nodes, int start, int end);
+
   //display helpers
   void preorderHelper(std::shared_ptr<BinaryNode<T>> node);
 
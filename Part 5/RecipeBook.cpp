@@ -20,8 +20,11 @@ The implementation includes functionality for adding, removing, finding, and dis
     * @post: The RecipeBook is populated with Recipes from the CSV file.
     * The file format is as follows: name,difficulty_level,description,mastered
     * Ignore the first line. Each subsequent line represents a Recipe to be added to the RecipeBook.
+    * @param self_balancing True to keep the tree an AVL tree from the first Recipe on.
     */
-    RecipeBook::RecipeBook(const std::string& filename) {
+    RecipeBook::RecipeBook(const std::string& filename, bool self_balancing) {
+    setSelfBalancing(self_balancing);
+
     // Open the specified CSV file
     std::ifstream file(filename);
     if (!file.is_open()) return;
@@ -29,30 +32,31 @@ The implementation includes functionality for adding, removing, finding, and dis
     std::string line;
     std::getline(file, line); // Skip the header line
 
-    // Process each line in the CSV file
+    // Parse every line first, so the tree is built once from all of them
+    std::vector<Recipe> recipes;
     while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string name, difficulty_str, description, mastered_str;
-        
-        // Parse the CSV line into individual fields
-        if (std::getline(ss, name, ',') && 
-            std::getline(ss, difficulty_str, ',') && 
-            std::getline(ss, description, ',') && 
-            std::getline(ss, mastered_str)) {
-            
-            try {
-                // Convert string values to appropriate types
-                int difficulty_level = std::stoi(difficulty_str);
-                bool mastered = (mastered_str == "true" || mastered_str == "1");
-                // Create and add the recipe to the tree
-                Recipe recipe(name, difficulty_level, description, mastered);
-                addRecipe(recipe);
-            } catch (const std::exception& e) {
-                continue; // Skip invalid entries
-            }
+        // Split at the first three commas; the mastered field is the rest of the line
+        size_t name_end = line.find(',');
+        size_t difficulty_end = name_end == std::string::npos ? name_end : line.find(',', name_end + 1);
+        size_t description_end = difficulty_end == std::string::npos ? difficulty_end : line.find(',', difficulty_end + 1);
+        if (description_end == std::string::npos || description_end + 1 == line.size()) {
+            continue; // Skip lines with missing fields
+        }
+
+        try {
+            // Convert string values to appropriate types
+            int difficulty_level = std::stoi(line.substr(name_end + 1, difficulty_end - name_end - 1));
+            std::string mastered_str = line.substr(description_end + 1);
+            bool mastered = (mastered_str == "true" || mastered_str == "1");
+            recipes.emplace_back(line.substr(0, name_end), difficulty_level,
+                                 line.substr(difficulty_end + 1, description_end - difficulty_end - 1), mastered);
+        } catch (const std::exception& e) {
+            continue; // Skip invalid entries
         }
     }
     file.close();
+
+    addRecipes(std::move(recipes));
 }
     /**
     * Adds a Recipe to the tree.
@@ -71,6 +75,47 @@ The implementation includes functionality for adding, removing, finding, and dis
     return true;
 }
 
+    /**
+    * Adds many Recipes at once and rebuilds the tree.
+    * @param recipes The Recipes to add, in any order.
+    * @post: Every Recipe whose name is not already in the tree is added; among
+    Recipes with the same name the first one in recipes wins. The tree is
+    rebuilt with minimal height.
+    * @return: The number of Recipes added.
+    */
+    int RecipeBook::addRecipes(std::vector<Recipe> recipes) {
+    // A nightly CSV is already sorted by name, which a linear check confirms; a stable sort keeps the first of equal names first
+    if (!std::is_sorted(recipes.begin(), recipes.end())) {
+        std::stable_sort(recipes.begin(), recipes.end());
+    }
+    recipes.erase(std::unique(recipes.begin(), recipes.end()), recipes.end());
+
+    // Merge with the recipes already in the tree, which win over new ones with the same name
+    std::vector<Recipe> existing = getSortedList(getRoot());
+    std::vector<Recipe> merged;
+    merged.reserve(existing.size() + recipes.size());
+    size_t old_pos = 0;
+    int added = 0;
+    for (Recipe& recipe : recipes) {
+        while (old_pos < existing.size() && existing[old_pos] < recipe) {
+            merged.push_back(std::move(existing[old_pos++]));
+        }
+        if (old_pos < existing.size() && existing[old_pos] == recipe) {
+            continue; // Already in the tree
+        }
+        merged.push_back(std::move(recipe));
+        added++;
+    }
+    while (old_pos < existing.size()) {
+        merged.push_back(std::move(existing[old_pos++]));
+    }
+
+    if (added > 0) {
+        setRoot(buildBalancedTree(merged, 0, static_cast<int>(merged.size()) - 1));
+    }
+    return added;
+}
+
 //Helper method to find a recipe node by name using recursive search
 std::shared_ptr<BinaryNode<Recipe>> RecipeBook::findNodeByName(std::shared_ptr<BinaryNode<Recipe>> subtree_ptr, const std::string &name) const {
     if (!subtree_ptr) return nullptr; // Base case: empty subtree
@@ -103,8 +103,13 @@ public:
     * name,difficulty_level,description,mastered
     * Ignore the first line. Each subsequent line represents a Recipe to be
     added to the RecipeBook.
+    * @param self_balancing True to keep the tree an AVL tree (see
+    setSelfBalancing) for later additions and removals.
+    * @note: All rows are read first and loaded with addRecipes, so the tree
+    starts at minimal height whatever the row order. If several rows share a
+    name, the first one wins.
     */
-    RecipeBook(const std::string &filename);
+    RecipeBook(const std::string &filename, bool self_balancing = false);
 
     /**
     * Adds a Recipe to the tree.
@@ -117,6 +122,18 @@ public:
     */
     bool addRecipe(const Recipe &recipe);
 
+    /**
+    * Adds many Recipes at once and rebuilds the tree.
+    * @param recipes The Recipes to add, in any order.
+    * @post: Every Recipe whose name is not already in the tree is added; among
+    Recipes with the same name the first one in recipes wins. The tree is
+    rebuilt with minimal height.
+    * @return: The number of Recipes added.
+    * @note: O(n + m log m) for n Recipes in the tree and m new ones, and
+    O(n + m) when recipes is already sorted by name.
+    */
+    int addRecipes(std::vector<Recipe> recipes);
+
     /**
     * Finds a Recipe in the tree by name.
     * @param name A const reference to a string representing the name of the
@@ -161,6 +178,8 @@ public:
     left and right subtrees differ by no more than 1.
     * @note: You may implement this by performing an inorder traversal to get
     sorted Recipes and rebuilding the tree.
+    * @note: A self-balancing RecipeBook is always balanced, so this is only
+    needed when self-balancing is off.
     */
     void balance();
 
@@ -0,0 +1,121 @@
+// bench.cpp drives RecipeBook with generated recipes and prints throughput and latency percentiles.
+// Usage: ./bench [recipes] [seed]   (without arguments it sweeps 10^3, 10^4 and 10^5 recipes)
+
+#include "RecipeBook.hpp"
+#include "../part 4/WorkloadGenerator.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Times addRecipe in random order, Zipfian findRecipe, removeRecipe and the load of a CSV sorted by name,
+// with a plain or a self-balancing (AVL) RecipeBook.
+void runBook(const std::vector<Recipe>& recipes, const std::vector<Recipe>& shuffled, const Workload& workload,
+             unsigned seed, bool self_balancing) {
+    const int num_recipes = static_cast<int>(recipes.size());
+    std::cout << "== " << num_recipes << " recipes (seed " << seed << "), "
+              << (self_balancing ? "self-balancing (AVL)" : "unbalanced") << " ==" << std::endl;
+
+    // Random insertion order through addRecipe.
+    RecipeBook book;
+    book.setSelfBalancing(self_balancing);
+    LatencyRecorder adds;
+    adds.reserve(shuffled.size());
+    uint64_t add_total = 0;
+    for (const Recipe& recipe : shuffled) {
+        auto start = LatencyRecorder::Clock::now();
+        book.addRecipe(recipe);
+        uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        adds.record(spent);
+        add_total += spent;
+    }
+    int height = book.getHeight();
+
+    // Lookups follow the Zipfian order stream.
+    LatencyRecorder finds;
+    finds.reserve(workload.orders.size());
+    uint64_t find_total = 0;
+    size_t hits = 0;
+    for (const OrderSpec& order : workload.orders) {
+        auto start = LatencyRecorder::Clock::now();
+        hits += book.findRecipe(workload.menu[order.dish_id].name) != nullptr;
+        uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        finds.record(spent);
+        find_total += spent;
+    }
+
+    // Remove every other recipe.
+    LatencyRecorder removes;
+    uint64_t remove_total = 0;
+    for (size_t i = 0; i < shuffled.size(); i += 2) {
+        auto start = LatencyRecorder::Clock::now();
+        book.removeRecipe(shuffled[i].name_);
+        uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        removes.record(spent);
+        remove_total += spent;
+    }
+
+    adds.report("addRecipe (random order)", add_total);
+    finds.report("findRecipe (zipf)", find_total);
+    removes.report("removeRecipe", remove_total);
+
+    // The nightly CSV arrives sorted by name; a shuffled one takes the sort path of the bulk load.
+    std::vector<Recipe> sorted = recipes;
+    std::sort(sorted.begin(), sorted.end());
+    for (bool shuffled_rows : {false, true}) {
+        const std::vector<Recipe>& rows = shuffled_rows ? shuffled : sorted;
+        std::string filename = "bench_recipes.csv";
+        std::ofstream csv(filename);
+        csv << "name,difficulty_level,description,mastered\n";
+        for (const Recipe& recipe : rows) {
+            csv << recipe.name_ << "," << recipe.difficulty_level_ << "," << recipe.description_ << "," << (recipe.mastered_ ? 1 : 0) << "\n";
+        }
+        csv.close();
+
+        LatencyRecorder load;
+        auto start = LatencyRecorder::Clock::now();
+        RecipeBook loaded(filename, self_balancing);
+        uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        load.record(spent);
+        load.report(shuffled_rows ? "RecipeBook(csv, shuffled)" : "RecipeBook(csv, sorted)", spent);
+        std::cout << "csv tree height " << loaded.getHeight() << ", recipes " << loaded.getNumberOfNodes() << std::endl;
+        std::remove(filename.c_str());
+    }
+    std::cout << "random-order tree height " << height << ", find hits " << hits << std::endl << std::endl;
+}
+
+void runScale(int num_recipes, unsigned seed) {
+    WorkloadConfig config;
+    config.seed = seed;
+    config.num_dishes = num_recipes;
+    config.num_orders = num_recipes;
+    config.num_ingredients = 16;
+    config.num_stations = 1;
+    Workload workload = WorkloadGenerator(config).generate();
+
+    std::vector<Recipe> recipes;
+    for (const DishSpec& dish : workload.menu) {
+        recipes.push_back(Recipe(dish.name, dish.prep_time % 10 + 1, "Serves " + std::to_string(dish.ingredients.size()), dish.kind == 0));
+    }
+
+    std::vector<Recipe> shuffled = recipes;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(seed));
+    for (bool self_balancing : {false, true}) {
+        runBook(recipes, shuffled, workload, seed, self_balancing);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 42;
+    if (argc > 1) {
+        runScale(std::stoi(argv[1]), seed);
+    } else {
+        for (int recipes : {1000, 10000, 100000, 1000000}) {
+            runScale(recipes, seed);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include "RecipeBook.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Checks the AVL balance of a subtree, and the heights its nodes store if they are kept (self-balancing trees)
+// @return the height of the subtree
+template <class T>
+int checkAvl(const std::shared_ptr<BinaryNode<T>>& node, std::vector<T>& inorder, bool stored_heights) {
+    if (node == nullptr) {
+        return 0;
+    }
+    int left_height = checkAvl(node->getLeftChildPtr(), inorder, stored_heights);
+    inorder.push_back(node->getItem());
+    int right_height = checkAvl(node->getRightChildPtr(), inorder, stored_heights);
+    int height = 1 + std::max(left_height, right_height);
+    assert((!stored_heights || node->getHeight() == height) && "Every node should store the height of its subtree.");
+    assert(std::abs(left_height - right_height) <= 1 && "Subtree heights should differ by at most 1.");
+    return height;
+}
+
+template <class T>
+std::vector<T> checkAvlTree(const BinarySearchTree<T>& tree) {
+    std::vector<T> inorder;
+    int height = checkAvl(tree.getRoot(), inorder, tree.isSelfBalancing());
+    assert(tree.getHeight() == height);
+    assert(std::is_sorted(inorder.begin(), inorder.end()) && std::adjacent_find(inorder.begin(), inorder.end()) == inorder.end());
+    assert(static_cast<int>(inorder.size()) == tree.getNumberOfNodes());
+    // An AVL tree of n nodes is at most about 1.44 log2(n + 2) high
+    assert(height <= 1.45 * std::log2(inorder.size() + 2.0));
+    return inorder;
+}
+
+void testAvlAddAndRemove() {
+    const int count = 1000;
+
+    // Sorted input degenerates an unbalanced tree into a list
+    BinarySearchTree<int> unbalanced;
+    for (int i = 0; i < 100; ++i) {
+        unbalanced.add(i);
+    }
+    assert(unbalanced.getHeight() == 100);
+
+    BinarySearchTree<int> tree;
+    tree.setSelfBalancing(true);
+    for (int i = 0; i < count; ++i) {
+        tree.add(i);
+    }
+    checkAvlTree(tree);
+    for (int i = count; i > 0; --i) {
+        tree.add(-i);
+    }
+    checkAvlTree(tree);
+
+    // Remove half the entries in a random order, checking the balance as the tree shrinks
+    std::vector<int> order;
+    for (int i = -count; i < count; ++i) {
+        order.push_back(i);
+    }
+    std::mt19937 random(7);
+    std::shuffle(order.begin(), order.end(), random);
+    for (int i = 0; i < count; ++i) {
+        assert(tree.remove(order[i]));
+        assert(!tree.contains(order[i]));
+        if (i % 50 == 0) {
+            checkAvlTree(tree);
+        }
+    }
+    assert(!tree.remove(order[0]) && "Removing a missing entry should fail.");
+    std::vector<int> kept(order.begin() + count, order.end());
+    std::sort(kept.begin(), kept.end());
+    assert(checkAvlTree(tree) == kept);
+
+    // Turning the mode on relinks a degenerate tree
+    unbalanced.setSelfBalancing(true);
+    checkAvlTree(unbalanced);
+    assert(unbalanced.getHeight() == 7);
+
+    // Copies and moves keep the mode
+    BinarySearchTree<int> copy(tree);
+    assert(copy.isSelfBalancing());
+    copy.add(count * 10);
+    checkAvlTree(copy);
+    BinarySearchTree<int> moved(std::move(copy));
+    assert(moved.isSelfBalancing() && moved.contains(count * 10));
+    std::cout << "Test passed: AVL add and remove keep the tree balanced.\n";
+}
+
+void testSelfBalancingRecipeBook() {
+    RecipeBook book;
+    book.setSelfBalancing(true);
+    for (int i = 0; i < 500; ++i) {
+        std::string name = "recipe" + std::string(i < 10 ? "00" : i < 100 ? "0" : "") + std::to_string(i);
+        assert(book.addRecipe(Recipe(name, i % 10 + 1, "description", i % 2 == 0)));
+    }
+    assert(!book.addRecipe(Recipe("recipe000", 1, "duplicate", false)));
+    checkAvlTree(book);
+    for (int i = 0; i < 500; i += 3) {
+        std::string name = "recipe" + std::string(i < 10 ? "00" : i < 100 ? "0" : "") + std::to_string(i);
+        assert(book.removeRecipe(name));
+    }
+    checkAvlTree(book);
+    assert(book.findRecipe("recipe001") != nullptr && book.findRecipe("recipe003") == nullptr);
+    std::cout << "Test passed: a self-balancing RecipeBook stays balanced.\n";
+}
+
+// Lists the recipes in name order
+std::vector<Recipe> recipesInOrder(const RecipeBook& book) {
+    std::vector<Recipe> inorder;
+    checkAvl(book.getRoot(), inorder, book.isSelfBalancing());
+    return inorder;
+}
+
+void testAddRecipesDedupAndMerge() {
+    RecipeBook book;
+    assert(book.addRecipe(Recipe("Pancakes", 2, "in the tree", false)));
+    assert(book.addRecipe(Recipe("Waffles", 3, "in the tree", true)));
+
+    // Unsorted input with repeated names: the first row of a name wins, and recipes already in the tree win
+    std::vector<Recipe> rows = {
+        Recipe("Omelette", 4, "first", false),
+        Recipe("Pancakes", 9, "loses to the tree", true),
+        Recipe("Bagels", 5, "first", true),
+        Recipe("Omelette", 6, "second", true),
+        Recipe("Crepes", 7, "first", false),
+        Recipe("Bagels", 8, "second", false),
+    };
+    assert(book.addRecipes(rows) == 3 && "Only the new names should be added.");
+    std::vector<Recipe> recipes = recipesInOrder(book);
+    std::vector<std::string> names;
+    for (const Recipe& recipe : recipes) {
+        names.push_back(recipe.name_);
+    }
+    assert((names == std::vector<std::string>{"Bagels", "Crepes", "Omelette", "Pancakes", "Waffles"}));
+    assert(recipes[0].description_ == "first" && recipes[0].difficulty_level_ == 5);
+    assert(recipes[2].description_ == "first" && recipes[2].difficulty_level_ == 4);
+    assert(recipes[3].description_ == "in the tree" && recipes[3].difficulty_level_ == 2);
+
+    // Sorted input takes the linear path and gives the same result
+    RecipeBook sorted_book;
+    std::vector<Recipe> sorted_rows;
+    for (int i = 0; i < 1000; ++i) {
+        std::string name = "recipe" + std::string(i < 10 ? "00" : i < 100 ? "0" : "") + std::to_string(i);
+        sorted_rows.emplace_back(name, i % 10 + 1, "description", false);
+        if (i % 4 == 0) {
+            sorted_rows.emplace_back(name, 0, "repeat", true);
+        }
+    }
+    assert(sorted_book.addRecipes(sorted_rows) == 1000);
+    checkAvlTree(sorted_book);
+    assert(sorted_book.getHeight() == 10 && "A bulk load should build a tree of minimal height.");
+    assert(sorted_book.findRecipe("recipe000")->getItem().description_ == "description");
+
+    assert(sorted_book.addRecipes({}) == 0 && sorted_book.getNumberOfNodes() == 1000);
+    assert(sorted_book.addRecipes({Recipe("recipe500", 1, "repeat", true), Recipe("zucchini", 1, "new", true)}) == 1);
+    assert(sorted_book.getNumberOfNodes() == 1001);
+    std::cout << "Test passed: addRecipes drops repeated names and merges with the tree.\n";
+}
+
+void testLoadFromCsv() {
+    const std::string filename = "test_recipes.csv";
+    {
+        std::ofstream file(filename);
+        file << "name,difficulty_level,description,mastered\n";
+        file << "Scones,3,tea time,1\n";
+        file << "Brioche,6,rich, buttery,0\n";
+        file << "Missing fields,4\n";
+        file << "Bad difficulty,hard,skipped,0\n";
+        file << "Scones,9,repeated,0\n";
+        file << "Focaccia,5,flat,true\n";
+    }
+    for (bool self_balancing : {false, true}) {
+        RecipeBook book(filename, self_balancing);
+        assert(book.isSelfBalancing() == self_balancing);
+        std::vector<Recipe> recipes = recipesInOrder(book);
+        assert(recipes.size() == 3 && "Rows with missing or invalid fields and repeated names should be skipped.");
+        assert(recipes[0].name_ == "Brioche" && recipes[0].description_ == "rich" && !recipes[0].mastered_);
+        assert(recipes[1].name_ == "Focaccia" && recipes[1].mastered_);
+        assert(recipes[2].name_ == "Scones" && recipes[2].difficulty_level_ == 3 && recipes[2].description_ == "tea time");
+    }
+    std::remove(filename.c_str());
+    std::cout << "Test passed: a CSV load skips bad rows and keeps the first of each name.\n";
+}
+
+int main() {
+    testAvlAddAndRemove();
+    testSelfBalancingRecipeBook();
+    testAddRecipesDedupAndMerge();
+    testLoadFromCsv();
+    return 0;
+}
@@ -0,0 +1,181 @@
+// EventLog.cpp contains the formatting of kitchen events and the null, buffered text and asynchronous file sinks.
+#include "EventLog.hpp"
+#include <stdexcept>
+
+namespace {
+
+// Text handed to the writer thread of an AsyncFileEventSink at a time
+const size_t ASYNC_CHUNK = 16 * 1024;
+
+} // namespace
+
+// Returns the verbosity level of an event type
+KitchenEvent::Level KitchenEvent::levelOf(Type type) {
+    switch (type) {
+        case REPLENISH_FAILED:
+        case DISH_NOT_PREPARED:
+            return WARNING;
+        case STATION_ATTEMPT:
+        case INGREDIENTS_SHORT:
+        case DISH_NOT_AVAILABLE:
+        case BATCH_SHORT:
+            return DEBUG;
+        default:
+            return INFO;
+    }
+}
+
+// Appends the line processAllDishes has always printed for this event
+void KitchenEvent::appendTo(std::string& text) const {
+    switch (type) {
+        case DISH_STARTED:
+            text.append("PREPARING DISH: ").append(dish);
+            break;
+        case STATION_ATTEMPT:
+            text.append(station).append(": attempting to prepare ").append(dish).append("...");
+            break;
+        case DISH_PREPARED:
+            text.append(station).append(": Successfully prepared ").append(dish).append(".");
+            break;
+        case INGREDIENTS_SHORT:
+            text.append(station).append(": Insufficient ingredients. Replenishing ingredients...");
+            break;
+        case REPLENISH_FAILED:
+            text.append(station).append(": Unable to replenish ingredients. Failed to prepare ").append(dish).append(".");
+            break;
+        case INGREDIENTS_REPLENISHED:
+            text.append(station).append(": Ingredients replenished.");
+            break;
+        case DISH_NOT_AVAILABLE:
+            text.append(station).append(": Dish not available. Moving to next station...");
+            break;
+        case DISH_NOT_PREPARED:
+            text.append(dish).append(" was not prepared.");
+            break;
+        case BATCH_STARTED:
+            text.append("PREPARING BATCH: ").append(dish).append(" x").append(std::to_string(quantity));
+            break;
+        case BATCH_SHORT:
+            text.append(station).append(": Insufficient ingredients for ").append(std::to_string(quantity))
+                .append(" x ").append(dish).append(". Replenishing ingredients...");
+            break;
+        case BATCH_PREPARED:
+            text.append(station).append(": Successfully prepared ").append(std::to_string(quantity))
+                .append(" x ").append(dish).append(".");
+            break;
+        case BACKUP_TRANSFER:
+            text.append(station).append(": Replenished ").append(std::to_string(quantity)).append(" ")
+                .append(dish).append(" from backup.");
+            break;
+        case SEPARATOR:
+            break;
+        case QUEUE_PROCESSED:
+            text.append("\n\nAll dishes have been processed.");
+            break;
+    }
+    text += '\n';
+}
+
+EventSink::EventSink(KitchenEvent::Level level) : level_(level) {
+}
+
+EventSink::~EventSink() {
+}
+
+// Null sink: level OFF, so accepts() rejects everything
+NullEventSink::NullEventSink() : EventSink(KitchenEvent::OFF) {
+}
+
+void NullEventSink::write(const KitchenEvent&) {
+}
+
+// Buffered text sink
+TextEventSink::TextEventSink(std::ostream& out, size_t buffer_size, KitchenEvent::Level level)
+    : EventSink(level), out_(out), buffer_size_(buffer_size) {
+    buffer_.reserve(buffer_size_ + 256);
+}
+
+TextEventSink::~TextEventSink() {
+    flush();
+}
+
+void TextEventSink::write(const KitchenEvent& event) {
+    event.appendTo(buffer_);
+    if (buffer_.size() >= buffer_size_) {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+}
+
+void TextEventSink::flush() {
+    if (!buffer_.empty()) {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+    out_.flush();
+}
+
+// Asynchronous file sink
+AsyncFileEventSink::AsyncFileEventSink(const std::string& filename, KitchenEvent::Level level)
+    : EventSink(level), file_(filename, std::ios::app), written_(0), submitted_(0), stopping_(false) {
+    if (!file_) {
+        throw std::runtime_error("Cannot open event log " + filename);
+    }
+    writer_ = std::thread(&AsyncFileEventSink::run, this);
+}
+
+AsyncFileEventSink::~AsyncFileEventSink() {
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+}
+
+void AsyncFileEventSink::write(const KitchenEvent& event) {
+    event.appendTo(local_);
+    if (local_.size() >= ASYNC_CHUNK) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.append(local_);
+            submitted_++;
+        }
+        local_.clear();
+        wake_.notify_one();
+    }
+}
+
+void AsyncFileEventSink::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!local_.empty()) {
+        pending_.append(local_);
+        local_.clear();
+        submitted_++;
+        wake_.notify_one();
+    }
+    size_t target = submitted_;
+    drained_.wait(lock, [this, target] { return written_ >= target; });
+}
+
+// Writer thread: takes everything pending, writes it without holding the lock, and reports progress
+void AsyncFileEventSink::run() {
+    std::string batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (pending_.empty() && stopping_) {
+            break;
+        }
+        batch.swap(pending_);
+        size_t target = submitted_;
+        lock.unlock();
+        file_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        file_.flush();
+        batch.clear();
+        lock.lock();
+        written_ = target;
+        drained_.notify_all();
+    }
+}
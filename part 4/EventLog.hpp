@@ -0,0 +1,160 @@
+/** Header file for the kitchen event log: the KitchenEvent record written by StationManager while it
+    processes the dish queue, and the sinks that receive it (null, buffered text and asynchronous file). **/
+
+#ifndef EVENTLOG_HPP
+#define EVENTLOG_HPP
+
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/**
+ * One structured event of processAllDishes. The views point into strings owned by the caller and are only
+ * valid during EventSink::write.
+ */
+struct KitchenEvent {
+    enum Level { OFF, WARNING, INFO, DEBUG }; ///< OFF is only meaningful as a sink level.
+
+    enum Type {
+        DISH_STARTED,            ///< "PREPARING DISH: <dish>"
+        STATION_ATTEMPT,         ///< "<station>: attempting to prepare <dish>..."
+        DISH_PREPARED,           ///< "<station>: Successfully prepared <dish>."
+        INGREDIENTS_SHORT,       ///< "<station>: Insufficient ingredients. Replenishing ingredients..."
+        REPLENISH_FAILED,        ///< "<station>: Unable to replenish ingredients. Failed to prepare <dish>."
+        INGREDIENTS_REPLENISHED, ///< "<station>: Ingredients replenished."
+        DISH_NOT_AVAILABLE,      ///< "<station>: Dish not available. Moving to next station..."
+        DISH_NOT_PREPARED,       ///< "<dish> was not prepared."
+        BATCH_STARTED,           ///< "PREPARING BATCH: <dish> x<quantity>"
+        BATCH_SHORT,             ///< "<station>: Insufficient ingredients for <quantity> x <dish>. Replenishing ingredients..."
+        BATCH_PREPARED,          ///< "<station>: Successfully prepared <quantity> x <dish>."
+        BACKUP_TRANSFER,         ///< "<station>: Replenished <quantity> <dish> from backup." (dish holds the ingredient)
+        SEPARATOR,               ///< An empty line between dishes
+        QUEUE_PROCESSED          ///< Two empty lines, then "All dishes have been processed."
+    };
+
+    Type type;
+    std::string_view station;
+    std::string_view dish;
+    int quantity;
+
+    /**
+     * @return: The verbosity level of an event type.
+     */
+    static Level levelOf(Type type);
+
+    /**
+     * Appends the text processAllDishes has always printed for this event, including the trailing newline.
+     */
+    void appendTo(std::string& text) const;
+};
+
+class EventSink {
+
+public:
+    /**
+     * @param level The most verbose level the sink accepts (DEBUG by default).
+     */
+    explicit EventSink(KitchenEvent::Level level = KitchenEvent::DEBUG);
+    virtual ~EventSink();
+
+    /**
+     * @return: True if events of the given level reach the sink; callers skip building other events.
+     */
+    bool accepts(KitchenEvent::Level level) const { return level <= level_; }
+
+    void setLevel(KitchenEvent::Level level) { level_ = level; }
+    KitchenEvent::Level getLevel() const { return level_; }
+
+    /**
+     * Records one event that passed accepts().
+     */
+    virtual void write(const KitchenEvent& event) = 0;
+
+    /**
+     * Pushes buffered events to their destination. StationManager calls it at the end of processAllDishes.
+     */
+    virtual void flush() {}
+
+private:
+    KitchenEvent::Level level_;
+};
+
+/**
+ * Drops every event; accepts() is false for all levels, so nothing is formatted.
+ */
+class NullEventSink : public EventSink {
+
+public:
+    NullEventSink();
+    void write(const KitchenEvent& event) override;
+};
+
+/**
+ * Formats events into a buffer and writes it to a stream when it fills up or on flush(), reproducing the
+ * text processAllDishes printed with std::cout and std::endl, without a flush per line.
+ */
+class TextEventSink : public EventSink {
+
+public:
+    /**
+     * @param out The stream to write to (std::cout by default); it must outlive the sink.
+     * @param buffer_size The number of bytes collected before writing to the stream.
+     */
+    explicit TextEventSink(std::ostream& out = std::cout, size_t buffer_size = 64 * 1024,
+                           KitchenEvent::Level level = KitchenEvent::DEBUG);
+    ~TextEventSink() override;
+
+    void write(const KitchenEvent& event) override;
+    void flush() override;
+
+private:
+    std::ostream& out_;
+    size_t buffer_size_;
+    std::string buffer_;
+};
+
+/**
+ * Formats events on the calling thread and appends them to a file from a background thread.
+ * write() and flush() must be called from one thread, the one driving the StationManager.
+ */
+class AsyncFileEventSink : public EventSink {
+
+public:
+    /**
+     * @param filename The file to append to.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    explicit AsyncFileEventSink(const std::string& filename, KitchenEvent::Level level = KitchenEvent::DEBUG);
+
+    /**
+     * Writes everything still pending, then stops the background thread.
+     */
+    ~AsyncFileEventSink() override;
+
+    void write(const KitchenEvent& event) override;
+
+    /**
+     * Blocks until every event written so far is in the file.
+     */
+    void flush() override;
+
+private:
+    void run();
+
+    std::ofstream file_;
+    std::mutex mutex_;
+    std::condition_variable wake_;    ///< Signals the writer thread that text is pending or the sink is stopping.
+    std::condition_variable drained_; ///< Signals flush() that the writer thread caught up.
+    std::string pending_;             ///< Text formatted but not yet handed to the writer thread.
+    std::string local_;               ///< Events of the current batch, moved to pending_ in chunks.
+    size_t written_;                  ///< Batches written by the writer thread.
+    size_t submitted_;                ///< Batches handed to the writer thread.
+    bool stopping_;
+    std::thread writer_;
+};
+
+#endif
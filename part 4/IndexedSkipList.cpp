@@ -0,0 +1,329 @@
+/** ADT list: Indexable skip list implementation.
+
+ Implementation file for the class IndexedSkipList.
+ Ranks are positions: the sentinel head has rank -1 and a null link reaches rank item_count_.
+ @file IndexedSkipList.cpp */
+
+#include "IndexedSkipList.hpp"  // Header file
+#include <string>
+#include <utility>
+
+// constructor
+template<class T>
+IndexedSkipList<T>::IndexedSkipList() : head_ptr_(new SkipNode(T(), MAX_LEVEL)), item_count_(0)
+{
+   for (int level = 0; level < MAX_LEVEL; level++)
+      head_ptr_->link(level).width = 1;
+}  // end default constructor
+
+
+// copy constructor
+template<class T>
+IndexedSkipList<T>::IndexedSkipList(const IndexedSkipList<T>& a_list) : IndexedSkipList()
+{
+   for (SkipNode* orig_ptr = a_list.getHeadNode(); orig_ptr != nullptr; orig_ptr = orig_ptr->getNext())
+      push_back(orig_ptr->item_);
+}  // end copy constructor
+
+
+// copy-and-swap assignment
+template<class T>
+IndexedSkipList<T>& IndexedSkipList<T>::operator=(IndexedSkipList<T> a_list)
+{
+   std::swap(head_ptr_, a_list.head_ptr_);
+   std::swap(item_count_, a_list.item_count_);
+   return *this;
+}  // end operator=
+
+
+// destructor
+template<class T>
+IndexedSkipList<T>::~IndexedSkipList()
+{
+   clear();
+   delete head_ptr_;
+}  // end destructor
+
+
+/**@return true if list is empty - item_count_ == 0 */
+template<class T>
+bool IndexedSkipList<T>::isEmpty() const
+{
+   return item_count_ == 0;
+}  // end isEmpty
+
+
+/**@return the number of items in the list - item_count_ */
+template<class T>
+int IndexedSkipList<T>::getLength() const
+{
+   return item_count_;
+}  // end getLength
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param new_entry to be inserted in list
+ @post new_entry is added at position in list (the entry previously at that position is now at position+1).
+       O(log n) expected
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T>
+bool IndexedSkipList<T>::insert(int position, const T& new_entry)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_);
+   if (able_to_insert)
+   {
+      SkipNode* update[MAX_LEVEL];
+      int rank[MAX_LEVEL];
+      findPredecessors(position, update, rank);
+
+      int levels = randomLevel();
+      SkipNode* new_node_ptr = new SkipNode(new_entry, levels);
+      for (int level = 0; level < MAX_LEVEL; level++)
+      {
+         typename SkipNode::Link& link = update[level]->link(level);
+         if (level < levels)
+         {
+            // Split the predecessor's link around the new node; what it reached moves one position on
+            new_node_ptr->link(level).next = link.next;
+            new_node_ptr->link(level).width = rank[level] + link.width + 1 - position;
+            link.next = new_node_ptr;
+            link.width = position - rank[level];
+         }
+         else
+         {
+            // The link passes over the new node
+            link.width++;
+         }  // end if
+      }  // end for
+      item_count_++;
+   }  // end if
+
+   return able_to_insert;
+}  // end insert
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is the last entry of the list */
+template<class T>
+void IndexedSkipList<T>::push_back(const T& new_entry)
+{
+   insert(item_count_, new_entry);
+}  // end push_back
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is the first entry of the list */
+template<class T>
+void IndexedSkipList<T>::push_front(const T& new_entry)
+{
+   insert(0, new_entry);
+}  // end push_front
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of deletion
+ @post entry at position is deleted, if any. List order is retained. O(log n) expected
+ @return true if there is an entry at position to be deleted, false otherwise */
+template<class T>
+bool IndexedSkipList<T>::remove(int position)
+{
+   bool able_to_remove = (position >= 0) && (position < item_count_);
+   if (able_to_remove)
+   {
+      SkipNode* update[MAX_LEVEL];
+      int rank[MAX_LEVEL];
+      findPredecessors(position, update, rank);
+
+      SkipNode* cur_ptr = update[0]->link(0).next;
+      int levels = cur_ptr->getLevels();
+      for (int level = 0; level < MAX_LEVEL; level++)
+      {
+         typename SkipNode::Link& link = update[level]->link(level);
+         if (level < levels)
+         {
+            // Bypass the removed node
+            link.width += cur_ptr->link(level).width - 1;
+            link.next = cur_ptr->link(level).next;
+         }
+         else
+         {
+            link.width--;
+         }  // end if
+      }  // end for
+
+      delete cur_ptr;
+      item_count_--;
+   }  // end if
+
+   return able_to_remove;
+}  // end remove
+
+
+/**@post the list is empty and item_count_ == 0*/
+template<class T>
+void IndexedSkipList<T>::clear()
+{
+   SkipNode* cur_ptr = head_ptr_->link(0).next;
+   while (cur_ptr != nullptr)
+   {
+      SkipNode* next_ptr = cur_ptr->link(0).next;
+      delete cur_ptr;
+      cur_ptr = next_ptr;
+   }  // end while
+
+   for (int level = 0; level < MAX_LEVEL; level++)
+      head_ptr_->link(level) = typename SkipNode::Link{nullptr, 1};
+   item_count_ = 0;
+}  // end clear
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating the position of the data to be retrieved
+ @return data item found at position, in O(log n) expected. If position is not a valid
+        position < item_count_ throws  PrecondViolatedExcep */
+template<class T>
+T IndexedSkipList<T>::getEntry(int position) const
+{
+   // Enforce precondition
+   bool ableToGet = (position >= 0) && (position < item_count_);
+   if (ableToGet)
+   {
+      return getNodeAt(position)->item_;
+   }
+   else
+   {
+      std::string message = "getEntry() called with an empty list or ";
+      message = message + "invalid position.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+}  // end getEntry
+
+
+//if position >= item_count_ returns nullptr
+template<class T>
+typename IndexedSkipList<T>::SkipNode* IndexedSkipList<T>::getPointerTo(size_t position) const
+{
+   SkipNode* find = nullptr;
+   if (position < static_cast<size_t>(item_count_))
+      find = getNodeAt(static_cast<int>(position));
+
+   return find;
+}  // end getPointerTo
+
+
+//returns the first node, nullptr if the list is empty
+template<class T>
+typename IndexedSkipList<T>::SkipNode* IndexedSkipList<T>::getHeadNode() const
+{
+   return head_ptr_->link(0).next;
+}  // end getHeadNode
+
+
+/**@return an iterator to the first entry, equal to end() if the list is empty */
+template<class T>
+typename IndexedSkipList<T>::iterator IndexedSkipList<T>::begin()
+{
+   return iterator(getHeadNode());
+}  // end begin
+
+template<class T>
+typename IndexedSkipList<T>::const_iterator IndexedSkipList<T>::begin() const
+{
+   return const_iterator(getHeadNode());
+}  // end begin
+
+template<class T>
+typename IndexedSkipList<T>::const_iterator IndexedSkipList<T>::cbegin() const
+{
+   return const_iterator(getHeadNode());
+}  // end cbegin
+
+
+/**@return an iterator past the last entry */
+template<class T>
+typename IndexedSkipList<T>::iterator IndexedSkipList<T>::end()
+{
+   return iterator(nullptr);
+}  // end end
+
+template<class T>
+typename IndexedSkipList<T>::const_iterator IndexedSkipList<T>::end() const
+{
+   return const_iterator(nullptr);
+}  // end end
+
+template<class T>
+typename IndexedSkipList<T>::const_iterator IndexedSkipList<T>::cend() const
+{
+   return const_iterator(nullptr);
+}  // end cend
+
+
+
+/************* PROTECTED METHODS ************/
+
+
+// Locates a specified node in this list.
+// @param position 0 <= position < item_count_
+// @return  A pointer to the node at the given position or nullptr if position is out of range
+template<class T>
+typename IndexedSkipList<T>::SkipNode* IndexedSkipList<T>::getNodeAt(int position) const
+{
+   if (position < 0 || position >= item_count_)
+      return nullptr;
+
+   // Take the widest links that do not pass the position, dropping a level when they would
+   SkipNode* cur_ptr = head_ptr_;
+   int cur_rank = -1;
+   for (int level = MAX_LEVEL - 1; level >= 0; level--)
+   {
+      while (cur_ptr->link(level).next != nullptr && cur_rank + cur_ptr->link(level).width <= position)
+      {
+         cur_rank += cur_ptr->link(level).width;
+         cur_ptr = cur_ptr->link(level).next;
+      }  // end while
+      if (cur_rank == position)
+         return cur_ptr;
+   }  // end for
+
+   return cur_ptr;
+}  // end getNodeAt
+
+
+// Finds, at every level, the last node before a position and that node's rank (the sentinel's is -1)
+template<class T>
+void IndexedSkipList<T>::findPredecessors(int position, SkipNode** update, int* rank) const
+{
+   SkipNode* cur_ptr = head_ptr_;
+   int cur_rank = -1;
+   for (int level = MAX_LEVEL - 1; level >= 0; level--)
+   {
+      while (cur_ptr->link(level).next != nullptr && cur_rank + cur_ptr->link(level).width < position)
+      {
+         cur_rank += cur_ptr->link(level).width;
+         cur_ptr = cur_ptr->link(level).next;
+      }  // end while
+      update[level] = cur_ptr;
+      rank[level] = cur_rank;
+   }  // end for
+}  // end findPredecessors
+
+
+// @return a height from 1 to MAX_LEVEL, each level above the first with chance 1/4
+template<class T>
+int IndexedSkipList<T>::randomLevel()
+{
+   int levels = 1;
+   while (levels < MAX_LEVEL && (level_generator_() & 3) == 0)
+      levels++;
+   return levels;
+}  // end randomLevel
+
+
+//  End of implementation file.
@@ -0,0 +1,190 @@
+/** ADT list: Indexable skip list implementation.
+    Entries keep the order they were inserted in, as in LinkedList, but every link of the skip list also
+    stores its width (how many positions it skips), so insert, remove, getEntry and getPointerTo find a
+    position in O(log n) expected time instead of walking from the head.
+    The public interface follows LinkedList: positions run from 0 to item_count_ - 1, getEntry throws
+    PrecondViolatedExcep for an invalid position, and getHeadNode returns the first node, whose getNext()
+    chain visits every entry in order. T must be default constructible.
+    @file IndexedSkipList.hpp */
+
+#ifndef INDEXED_SKIP_LIST_
+#define INDEXED_SKIP_LIST_
+
+#include "PrecondViolatedExcep.hpp"
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+template<class T>
+class IndexedSkipList
+{
+
+public:
+   /** A node of the skip list; level 0 links every entry in order */
+   class SkipNode
+   {
+   public:
+      /**@return the entry held by the node */
+      T getItem() const { return item_; }
+      T& getItemRef() { return item_; }
+      const T& getItemRef() const { return item_; }
+
+      /**@return the next node in list order, nullptr for the last one */
+      SkipNode* getNext() const { return bottom_.next; }
+
+   private:
+      friend class IndexedSkipList<T>;
+
+      // next is the following node at this level; width is the number of positions from this node to next,
+      // or to one past the last entry when next is nullptr
+      struct Link {
+         SkipNode* next;
+         int width;
+      };
+
+      SkipNode(const T& an_item, int levels) : item_(an_item), bottom_{nullptr, 0}, upper_(levels - 1, Link{nullptr, 0}) {}
+
+      // The link at a level, 0 <= level < getLevels()
+      Link& link(int level) { return level == 0 ? bottom_ : upper_[level - 1]; }
+      const Link& link(int level) const { return level == 0 ? bottom_ : upper_[level - 1]; }
+
+      int getLevels() const { return 1 + static_cast<int>(upper_.size()); }
+
+      T item_;
+      Link bottom_;              // Level 0 is kept in the node, so a traversal reads no other memory
+      std::vector<Link> upper_;  // Levels 1 and up; empty for three nodes in four
+   }; // end SkipNode
+
+   /** Forward iterator over the entries in list order; Item is T, or const T for const_iterator */
+   template<class Item>
+   class ListIterator
+   {
+   public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = Item*;
+      using reference = Item&;
+
+      ListIterator() : node_ptr_(nullptr) {}
+      explicit ListIterator(SkipNode* node_ptr) : node_ptr_(node_ptr) {}
+
+      // An iterator converts to a const_iterator
+      template<class Other, class = std::enable_if_t<std::is_same_v<Other, T> && std::is_const_v<Item>>>
+      ListIterator(const ListIterator<Other>& other) : node_ptr_(other.getNode()) {}
+
+      reference operator*() const { return node_ptr_->getItemRef(); }
+      pointer operator->() const { return &node_ptr_->getItemRef(); }
+
+      ListIterator& operator++()
+      {
+         node_ptr_ = node_ptr_->getNext();
+         return *this;
+      }
+
+      ListIterator operator++(int)
+      {
+         ListIterator previous = *this;
+         node_ptr_ = node_ptr_->getNext();
+         return previous;
+      }
+
+      bool operator==(const ListIterator& other) const { return node_ptr_ == other.node_ptr_; }
+      bool operator!=(const ListIterator& other) const { return node_ptr_ != other.node_ptr_; }
+
+      SkipNode* getNode() const { return node_ptr_; }
+
+   private:
+      SkipNode* node_ptr_;
+   }; // end ListIterator
+
+   using iterator = ListIterator<T>;
+   using const_iterator = ListIterator<const T>;
+
+   IndexedSkipList(); // constructor
+   IndexedSkipList(const IndexedSkipList<T>& a_list); // copy constructor
+   IndexedSkipList<T>& operator=(IndexedSkipList<T> a_list); // copy-and-swap assignment
+   virtual ~IndexedSkipList(); // destructor
+
+   /**@return true if list is empty - item_count_ == 0 */
+   bool isEmpty() const;
+
+   /**@return the number of items in the list - item_count_ */
+   int getLength() const;
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param new_entry to be inserted in list
+     @post new_entry is added at position in list (the entry previously at that position is now at position+1).
+           O(log n) expected
+     @return true if valid position (0 <= position <= item_count_) */
+   bool insert(int position, const T& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is the last entry of the list */
+   void push_back(const T& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is the first entry of the list */
+   void push_front(const T& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of deletion
+     @post entry at position is deleted, if any. List order is retained. O(log n) expected
+     @return true if there is an entry at position to be deleted, false otherwise */
+   bool remove(int position);
+
+   /**@post the list is empty and item_count_ == 0*/
+   void clear();
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating the position of the data to be retrieved
+     @return data item found at position, in O(log n) expected. If position is not a valid
+            position < item_count_ throws  PrecondViolatedExcep */
+   T getEntry(int position) const;
+
+   //if position >= item_count_ returns nullptr
+   SkipNode* getPointerTo(size_t position) const;
+
+   //returns the first node, nullptr if the list is empty
+   SkipNode* getHeadNode() const;
+
+   /**@return an iterator to the first entry, equal to end() if the list is empty */
+   iterator begin();
+   const_iterator begin() const;
+   const_iterator cbegin() const;
+
+   /**@return an iterator past the last entry */
+   iterator end();
+   const_iterator end() const;
+   const_iterator cend() const;
+
+protected:
+   static const int MAX_LEVEL = 16;  // Enough for 4^16 entries with a promotion chance of 1/4
+
+   SkipNode* head_ptr_;   // Sentinel holding MAX_LEVEL links; it is not an entry
+   int item_count_;       // Current count of list items
+   std::minstd_rand level_generator_;  // Draws node heights; seeded the same for every list
+
+   // Locates a specified node in this list.
+   // @param position 0 <= position < item_count_
+   // @return  A pointer to the node at the given position or nullptr if position is out of range
+   SkipNode* getNodeAt(int position) const;
+
+   // Finds, at every level, the last node before a position and that node's rank (the sentinel's is -1)
+   void findPredecessors(int position, SkipNode** update, int* rank) const;
+
+   // @return a height from 1 to MAX_LEVEL, each level above the first with chance 1/4
+   int randomLevel();
+
+}; // end IndexedSkipList
+
+#include "IndexedSkipList.cpp"
+#endif
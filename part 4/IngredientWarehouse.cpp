@@ -0,0 +1,114 @@
+// IngredientWarehouse.cpp contains the implementation of the IngredientWarehouse class, the backup ingredient store of the StationManager.
+#include "IngredientWarehouse.hpp"
+
+// Default Constructor
+IngredientWarehouse::IngredientWarehouse() : total_value_(0.0), stocked_count_(0) {
+}
+
+// Adds stock of one ingredient, merging it with existing stock of the same name
+bool IngredientWarehouse::add(const Ingredient& ingredient) {
+    if (ingredient.quantity < 0) {
+        return false;
+    }
+    size_t slot_index;
+    auto found = index_.find(ingredient.name);
+    if (found == index_.end()) {
+        slot_index = slots_.size();
+        index_.emplace(ingredient.name, slot_index);
+        slots_.push_back(ingredient);
+        slots_.back().quantity = 0;
+    } else {
+        slot_index = found->second;
+        if (slots_[slot_index].quantity == 0) {
+            // Reusing an emptied slot: the ingredient is stocked again at its new price
+            slots_[slot_index].price = ingredient.price;
+        }
+    }
+
+    Ingredient& slot = slots_[slot_index];
+    if (slot.quantity == 0 && ingredient.quantity > 0) {
+        stocked_count_++;
+    }
+    slot.quantity += ingredient.quantity;
+    total_value_ += ingredient.quantity * slot.price;
+    return true;
+}
+
+// Adds a batch of ingredients
+bool IngredientWarehouse::addAll(const std::vector<Ingredient>& ingredients) {
+    slots_.reserve(slots_.size() + ingredients.size());
+    index_.reserve(index_.size() + ingredients.size());
+    bool all_added = true;
+    for (const Ingredient& ingredient : ingredients) {
+        all_added = add(ingredient) && all_added;
+    }
+    return all_added;
+}
+
+// Removes stock of one ingredient if enough is available
+bool IngredientWarehouse::take(const std::string& name, int quantity) {
+    auto found = index_.find(name);
+    if (found == index_.end() || quantity < 0) {
+        return false;
+    }
+    Ingredient& slot = slots_[found->second];
+    if (slot.quantity < quantity) {
+        return false;
+    }
+    slot.quantity -= quantity;
+    total_value_ -= quantity * slot.price;
+    if (slot.quantity == 0 && quantity > 0) {
+        stocked_count_--;
+    }
+    if (stocked_count_ == 0) {
+        total_value_ = 0.0; // Drop accumulated rounding error
+    }
+    return true;
+}
+
+// Finds a stocked ingredient by name
+const Ingredient* IngredientWarehouse::find(const std::string& name) const {
+    auto found = index_.find(name);
+    if (found == index_.end() || slots_[found->second].quantity == 0) {
+        return nullptr;
+    }
+    return &slots_[found->second];
+}
+
+// Quantity in stock of one ingredient
+int IngredientWarehouse::getQuantity(const std::string& name) const {
+    const Ingredient* ingredient = find(name);
+    return ingredient ? ingredient->quantity : 0;
+}
+
+double IngredientWarehouse::getTotalValue() const {
+    return total_value_;
+}
+
+int IngredientWarehouse::getStockedCount() const {
+    return stocked_count_;
+}
+
+bool IngredientWarehouse::isEmpty() const {
+    return stocked_count_ == 0;
+}
+
+// Ingredients in stock, in the order they were first added
+std::vector<Ingredient> IngredientWarehouse::getIngredients() const {
+    std::vector<Ingredient> stocked;
+    stocked.reserve(stocked_count_);
+    for (const Ingredient& slot : slots_) {
+        if (slot.quantity > 0) {
+            stocked.push_back(slot);
+        }
+    }
+    return stocked;
+}
+
+// Removes all stock
+void IngredientWarehouse::clear() {
+    slots_.clear();
+    index_.clear();
+    total_value_ = 0.0;
+    stocked_count_ = 0;
+}
@@ -0,0 +1,90 @@
+/** Header file for the IngredientWarehouse class, a keyed store of backup ingredients with constant-time
+    lookup by name and a running total of the stock value. **/
+
+#ifndef INGREDIENTWAREHOUSE_HPP
+#define INGREDIENTWAREHOUSE_HPP
+
+#include "Dish.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class IngredientWarehouse {
+
+public:
+    /**
+     * Default Constructor
+     * @post: Initializes an empty warehouse.
+     */
+    IngredientWarehouse();
+
+    /**
+     * Adds stock of one ingredient.
+     * @param ingredient The ingredient to add; its quantity is added to any existing stock of the same name.
+     * @post: An ingredient that is still in stock keeps its current price; otherwise the given price is used.
+     * @return: True if the ingredient was added; false if its quantity is negative.
+     */
+    bool add(const Ingredient& ingredient);
+
+    /**
+     * Adds a batch of ingredients, merging each one into the existing stock.
+     * @param ingredients The ingredients to add.
+     * @return: True if every ingredient was added; false otherwise.
+     */
+    bool addAll(const std::vector<Ingredient>& ingredients);
+
+    /**
+     * Removes stock of one ingredient.
+     * @param name The name of the ingredient.
+     * @param quantity The amount to remove.
+     * @return: True if at least quantity was in stock and was removed; false otherwise (the stock is unchanged).
+     */
+    bool take(const std::string& name, int quantity);
+
+    /**
+     * @param name The name of the ingredient.
+     * @return: A pointer to the stocked ingredient, or nullptr if none is in stock.
+     *          The pointer is valid until the next call to add, addAll or clear.
+     */
+    const Ingredient* find(const std::string& name) const;
+
+    /**
+     * @param name The name of the ingredient.
+     * @return: The quantity in stock, 0 if the ingredient is not stocked.
+     */
+    int getQuantity(const std::string& name) const;
+
+    /**
+     * @return: The total value (quantity times price) of the stock, maintained on every change.
+     */
+    double getTotalValue() const;
+
+    /**
+     * @return: The number of distinct ingredients currently in stock.
+     */
+    int getStockedCount() const;
+
+    /**
+     * @return: True if nothing is in stock; false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @return: The ingredients currently in stock, in the order they were first added.
+     */
+    std::vector<Ingredient> getIngredients() const;
+
+    /**
+     * Removes all stock.
+     * @post: The warehouse is empty.
+     */
+    void clear();
+
+private:
+    std::vector<Ingredient> slots_; ///< One slot per ingredient ever stocked; empty slots are kept and reused.
+    std::unordered_map<std::string, size_t> index_; ///< Ingredient name to slot.
+    double total_value_; ///< Sum of quantity times price over all slots.
+    int stocked_count_; ///< Number of slots with a positive quantity.
+};
+
+#endif // INGREDIENTWAREHOUSE_HPP
@@ -1,4 +1,8 @@
 #include "KitchenStation.hpp"
+#include "OrderTracer.hpp"
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
 
 KitchenStation::KitchenStation() 
     : station_name_("UNKNOWN"), dishes_({}), ingredients_stock_({}) {
@@ -62,10 +66,16 @@ void KitchenStation::replenishStationIngredients(const Ingredient& ingredient) {
             // std::cout<< "We are adding "<< ingredient.quantity << " of "<< ingredient.name << std::endl;
             stock_ingredient.quantity += ingredient.quantity;
             // std::cout<< "We now have "<< stock_ingredient.quantity << " of "<< stock_ingredient.name << std::endl;
+            if (stock_listener_) {
+                stock_listener_(ingredient.name);
+            }
             return;
         }
     }
     ingredients_stock_.push_back(ingredient);
+    if (stock_listener_) {
+        stock_listener_(ingredient.name);
+    }
 }
 
 bool KitchenStation::canCompleteOrder(const std::string& dish_name) const {
@@ -102,7 +112,8 @@ bool KitchenStation::canCompleteOrder(const std::string& dish_name) const {
     return false;
 }
 
-bool KitchenStation::prepareDish(const std::string& dish_name) {
+bool KitchenStation::prepareDish(const std::string& dish_name, const void* order) {
+    OrderTracer::Scope trace("prepareDish", order, dish_name);
     if (!canCompleteOrder(dish_name)) {
         return false;
     }
@@ -154,4 +165,121 @@ bool KitchenStation::removeIngredient(const std::string& ingredient_name) {
         }
     }
     return false;
-}
\ No newline at end of file
+}
+
+Dish* KitchenStation::getDish(const std::string& dish_name) const {
+    for (Dish* dish : dishes_) {
+        if (dish->getName() == dish_name) {
+            return dish;
+        }
+    }
+    return nullptr;
+}
+
+int KitchenStation::servingsAvailable(const std::string& dish_name) const {
+    Dish* dish = getDish(dish_name);
+    if (dish == nullptr) {
+        return 0;
+    }
+    int servings = -1; // -1 until an ingredient limits it
+    for (const Ingredient& ingredient : dish->getIngredients()) {
+        if (ingredient.required_quantity <= 0) {
+            continue;
+        }
+        int in_stock = 0;
+        for (const Ingredient& stock_ingredient : ingredients_stock_) {
+            if (stock_ingredient.name == ingredient.name) {
+                in_stock = stock_ingredient.quantity;
+                break;
+            }
+        }
+        int covered = in_stock / ingredient.required_quantity;
+        if (servings < 0 || covered < servings) {
+            servings = covered;
+        }
+    }
+    // a dish that needs no ingredients is never limited by stock
+    return servings < 0 ? std::numeric_limits<int>::max() : servings;
+}
+
+bool KitchenStation::prepareDishes(const std::string& dish_name, int servings, const void* order) {
+    OrderTracer::Scope trace("prepareDish", order, dish_name);
+    if (servings <= 0 || servingsAvailable(dish_name) < servings) {
+        return false;
+    }
+    // Deduct the combined requirement; servingsAvailable already checked every ingredient
+    for (const Ingredient& ingredient : getDish(dish_name)->getIngredients()) {
+        for (Ingredient& stock_ingredient : ingredients_stock_) {
+            if (stock_ingredient.name == ingredient.name) {
+                stock_ingredient.quantity -= ingredient.required_quantity * servings;
+                if (stock_ingredient.quantity == 0) {
+                    removeIngredient(stock_ingredient.name);
+                }
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void KitchenStation::absorbStation(KitchenStation& other) {
+    if (&other == this) {
+        return;
+    }
+
+    // Dishes: take the whole vector when this station has none, otherwise keep the first copy of each name
+    if (dishes_.empty()) {
+        dishes_ = std::move(other.dishes_);
+    } else {
+        std::unordered_set<std::string> names;
+        std::unordered_set<const Dish*> kept;
+        names.reserve(dishes_.size() + other.dishes_.size());
+        kept.reserve(dishes_.size() + other.dishes_.size());
+        for (Dish* dish : dishes_) {
+            names.insert(dish->getName());
+            kept.insert(dish);
+        }
+        dishes_.reserve(dishes_.size() + other.dishes_.size());
+        for (Dish* dish : other.dishes_) {
+            if (names.insert(dish->getName()).second) {
+                dishes_.push_back(dish);
+                kept.insert(dish);
+            } else if (kept.count(dish) == 0) {
+                delete dish; // a distinct copy of a dish this station already owns
+            }
+            // else both stations hold this very object; this station keeps it
+        }
+    }
+    other.dishes_.clear();
+
+    // Stock: one hashed pass combines quantities of the same ingredient
+    if (ingredients_stock_.empty()) {
+        ingredients_stock_ = std::move(other.ingredients_stock_);
+    } else {
+        std::unordered_map<std::string, size_t> index;
+        index.reserve(ingredients_stock_.size() + other.ingredients_stock_.size());
+        for (size_t i = 0; i < ingredients_stock_.size(); ++i) {
+            index.emplace(ingredients_stock_[i].name, i);
+        }
+        ingredients_stock_.reserve(ingredients_stock_.size() + other.ingredients_stock_.size());
+        for (Ingredient& ingredient : other.ingredients_stock_) {
+            auto found = index.find(ingredient.name);
+            if (found == index.end()) {
+                index.emplace(ingredient.name, ingredients_stock_.size());
+                ingredients_stock_.push_back(std::move(ingredient));
+            } else {
+                ingredients_stock_[found->second].quantity += ingredient.quantity;
+            }
+        }
+    }
+    other.ingredients_stock_.clear();
+    if (stock_listener_) {
+        for (const Ingredient& ingredient : ingredients_stock_) {
+            stock_listener_(ingredient.name);
+        }
+    }
+}
+
+void KitchenStation::setStockListener(std::function<void(const std::string&)> listener) {
+    stock_listener_ = std::move(listener);
+}
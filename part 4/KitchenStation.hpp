@@ -1,10 +1,12 @@
 #ifndef KITCHENSTATION_HPP
+#define KITCHENSTATION_HPP
 
 #include <iostream>
 #include <vector>
 #include <string>
 #include <iomanip>
 #include <cctype>
+#include <functional>
 #include "Dish.hpp"
 
 class KitchenStation {
@@ -13,6 +15,7 @@ class KitchenStation {
         std::string station_name_;
         std::vector<Dish*> dishes_;
         std::vector<Ingredient> ingredients_stock_;
+        std::function<void(const std::string&)> stock_listener_;
 
         bool isPresent(const std::string& dish_name) const;
         bool removeIngredient(const std::string& ingredient_name);
@@ -34,7 +37,22 @@ class KitchenStation {
         bool assignDishToStation(Dish* dish);
         void replenishStationIngredients(const Ingredient& ingredient);
         bool canCompleteOrder(const std::string& dish_name) const;
-        bool prepareDish(const std::string& dish_name);
+        // order, the queued dish being served, only ties the trace span to that order
+        bool prepareDish(const std::string& dish_name, const void* order = nullptr);
+
+        // get the station's own copy of a dish, or nullptr if the station does not carry it
+        Dish* getDish(const std::string& dish_name) const;
+        // number of servings of a dish the current stock covers (0 if the dish is not carried)
+        int servingsAvailable(const std::string& dish_name) const;
+        // prepare several servings of a dish at once, deducting the whole requirement in one pass;
+        // all-or-nothing: returns false and leaves the stock untouched if any ingredient is short; order as for prepareDish
+        bool prepareDishes(const std::string& dish_name, int servings, const void* order = nullptr);
+        // move every dish and all stock of other into this station, leaving other empty; a dish of a name this
+        // station already carries is deleted only if it is a distinct object (a Dish* both stations hold is kept
+        // once), stock of the same ingredient is combined; linear in the size of both
+        void absorbStation(KitchenStation& other);
+        // called with the ingredient name whenever stock is added; nullptr removes the listener
+        void setStockListener(std::function<void(const std::string&)> listener);
 
 };
 
@@ -15,39 +15,39 @@
 #include <cassert>
 
 // constructor
-template<class T>
-LinkedList<T>::LinkedList() : head_ptr_(nullptr), item_count_(0)
+template<class T, class Allocator>
+LinkedList<T, Allocator>::LinkedList() : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0)
 {
 }  // end default constructor
 
 
 // copy constructor
-template<class T>
-LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item_count_)
+template<class T, class Allocator>
+LinkedList<T, Allocator>::LinkedList(const LinkedList<T, Allocator>& a_list) : item_count_(a_list.item_count_)
 {
    Node<T>* orig_chain_pointer = a_list.head_ptr_;  // Points to nodes in original chain
 
    if (orig_chain_pointer == nullptr)
+   {
       head_ptr_ = nullptr;  // Original list is empty
+      tail_ptr_ = nullptr;
+   }
    else
    {
       // Copy first node
-      head_ptr_ = new Node<T>();
-      head_ptr_->setItem(orig_chain_pointer->getItem());
+      head_ptr_ = allocator_.create(orig_chain_pointer->getItemRef());
 
       // Copy remaining nodes
       Node<T>* new_chain_ptr = head_ptr_;      // Points to last node in new chain
       orig_chain_pointer = orig_chain_pointer->getNext();     // Advance original-chain pointer
       while (orig_chain_pointer != nullptr)
       {
-         // Get next item from original chain
-         T next_item = orig_chain_pointer->getItem();
-
-         // Create a new node containing the next item
-         Node<T>* new_node_ptr = new Node<T>(next_item);
+         // Create a new node containing the next item from original chain
+         Node<T>* new_node_ptr = allocator_.create(orig_chain_pointer->getItemRef());
 
          // Link new node to end of new chain
          new_chain_ptr->setNext(new_node_ptr);
+         new_node_ptr->setPrevious(new_chain_ptr);
 
          // Advance pointer to new last node
          new_chain_ptr = new_chain_ptr->getNext();
@@ -57,13 +57,46 @@ LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item
       }  // end while
 
       new_chain_ptr->setNext(nullptr);              // Flag end of chain
+      tail_ptr_ = new_chain_ptr;
    }  // end if
 }  // end copy constructor
 
 
+// move constructor: takes a_list's nodes in O(1)
+template<class T, class Allocator>
+LinkedList<T, Allocator>::LinkedList(LinkedList<T, Allocator>&& a_list) noexcept
+   : head_ptr_(a_list.head_ptr_), tail_ptr_(a_list.tail_ptr_), item_count_(a_list.item_count_),
+     allocator_(std::move(a_list.allocator_))
+{
+   a_list.head_ptr_ = nullptr;
+   a_list.tail_ptr_ = nullptr;
+   a_list.item_count_ = 0;
+}  // end move constructor
+
+
+// copy-and-swap (and move) assignment: a_list is a copy or a moved-from list, and takes the old entries with it
+template<class T, class Allocator>
+LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(LinkedList<T, Allocator> a_list)
+{
+   swap(a_list);
+   return *this;
+}  // end operator=
+
+
+/**@post this list and a_list have exchanged their entries, in O(1) */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::swap(LinkedList<T, Allocator>& a_list) noexcept
+{
+   std::swap(head_ptr_, a_list.head_ptr_);
+   std::swap(tail_ptr_, a_list.tail_ptr_);
+   std::swap(item_count_, a_list.item_count_);
+   allocator_.swap(a_list.allocator_);
+}  // end swap
+
+
 // destructor
-template<class T>
-LinkedList<T>::~LinkedList()
+template<class T, class Allocator>
+LinkedList<T, Allocator>::~LinkedList()
 {
    clear();
 }  // end destructor
@@ -71,16 +104,16 @@ LinkedList<T>::~LinkedList()
 
 
 /**@return true if list is empty - item_count_ == 0 */
-template<class T>
-bool LinkedList<T>::isEmpty() const
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::isEmpty() const
 {
    return item_count_ == 0;
 }  // end isEmpty
 
 
 /**@return the number of items in the list - item_count_ */
-template<class T>
-int LinkedList<T>::getLength() const
+template<class T, class Allocator>
+int LinkedList<T, Allocator>::getLength() const
 {
    return item_count_;
 }  // end getLength
@@ -93,35 +126,76 @@ int LinkedList<T>::getLength() const
  @param new_entry to be inserted in list
  @post new_entry is added at position in list (the node previously at that position is now at position+1)
  @return true if valid position (0 <= position <= item_count_) */
-template<class T>
-bool LinkedList<T>::insert(int positions, const T& new_entry)
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::insert(int positions, const T& new_entry)
 {
-   bool able_to_insert = (positions >= 0) && (positions <= item_count_ );
+   return emplace(positions, new_entry);
+}  // end insert
+
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::insert(int positions, T&& new_entry)
+{
+   return emplace(positions, std::move(new_entry));
+}  // end insert
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param args to construct the new entry from, in place in its node
+ @post the new entry is added at position in list
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T, class Allocator>
+template<class... Args>
+bool LinkedList<T, Allocator>::emplace(int position, Args&&... args)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_ );
    if (able_to_insert)
    {
-      // Create a new node containing the new entry
-      Node<T>* new_node_ptr = new Node<T>(new_entry);
+      // Find the node that will follow the new node; appending needs no walk
+      Node<T>* next_ptr = (position == item_count_) ? nullptr : getNodeAt(position);
 
-      // Attach new node to chain
-      if (positions == 0)
-      {
-         // Insert new node at beginning of chain
-         new_node_ptr->setNext(head_ptr_);
-         head_ptr_ = new_node_ptr;
-      }
-      else
-      {
-         // Find node that will be before new node
-         Node<T>* prev_ptr = getNodeAt(positions - 1);
-         // Insert new node after node to which prev_ptr points
-         new_node_ptr->setNext(prev_ptr->getNext());
-         prev_ptr->setNext(new_node_ptr);
-      }  // end if
-      item_count_++;  // Increase count of entries
+      // Create a new node containing the new entry and attach it to the chain
+      linkBefore(next_ptr, allocator_.create(std::forward<Args>(args)...));
    }  // end if
 
    return able_to_insert;
-}  // end insert
+}  // end emplace
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is the last entry of the list; O(1) through tail_ptr_ */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::push_back(const T& new_entry)
+{
+   insert(item_count_, new_entry);
+}  // end push_back
+
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::push_back(T&& new_entry)
+{
+   insert(item_count_, std::move(new_entry));
+}  // end push_back
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is the first entry of the list */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::push_front(const T& new_entry)
+{
+   insert(0, new_entry);
+}  // end push_front
+
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::push_front(T&& new_entry)
+{
+   insert(0, std::move(new_entry));
+}  // end push_front
 
 
 
@@ -130,38 +204,18 @@ bool LinkedList<T>::insert(int positions, const T& new_entry)
  @param position indicating point of deletion
  @post node at position is deleted, if any. List order is retains
  @return true if there is a node at position to be deleted, false otherwise */
-template<class T>
-bool LinkedList<T>::remove(int position)
+template<class T, class Allocator>
+bool LinkedList<T, Allocator>::remove(int position)
 {
    bool able_to_remove = (position >= 0) && (position < item_count_);
    if (able_to_remove)
    {
-      Node<T>* cur_ptr = nullptr;
-      if (position == 0)
-      {
-         // Remove the first node in the chain
-         cur_ptr = head_ptr_; // Save pointer to node
-         head_ptr_ = head_ptr_->getNext();
-      }
-      else
-      {
-         // Find node that is before the one to delete
-         Node<T>* prev_ptr = getNodeAt(position - 1);
+      // Disconnect indicated node from chain by connecting its neighbors
+      Node<T>* cur_ptr = getNodeAt(position);
+      unlink(cur_ptr);
 
-         // Point to node to delete
-         cur_ptr = prev_ptr->getNext();
-
-         // Disconnect indicated node from chain by connecting the
-         // prior node with the one after
-         prev_ptr->setNext(cur_ptr->getNext());
-      }  // end if
-
-      // Return node to system
-      cur_ptr->setNext(nullptr);
-      delete cur_ptr;
-      cur_ptr = nullptr;
-
-      item_count_--;  // Decrease count of entries
+      // Return node to the allocator, which may hand it out again
+      allocator_.destroy(cur_ptr);
    }  // end if
 
    return able_to_remove;
@@ -169,12 +223,26 @@ bool LinkedList<T>::remove(int position)
 
 
 
-/**@post the list is empty and item_count_ == 0*/
-template<class T>
-void LinkedList<T>::clear()
+/**@post the list is empty and item_count_ == 0.
+   O(1) when the allocator can release all nodes at once (the default NodePool, for trivially
+   destructible T); otherwise the nodes are destroyed one by one */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::clear()
 {
-   while (!isEmpty())
-      remove(0);
+   if (!allocator_.release())
+   {
+      Node<T>* cur_ptr = head_ptr_;
+      while (cur_ptr != nullptr)
+      {
+         Node<T>* next_ptr = cur_ptr->getNext();
+         allocator_.destroy(cur_ptr);
+         cur_ptr = next_ptr;
+      }  // end while
+   }  // end if
+
+   head_ptr_ = nullptr;
+   tail_ptr_ = nullptr;
+   item_count_ = 0;
 }  // end clear
 
 
@@ -184,8 +252,8 @@ void LinkedList<T>::clear()
  @param position indicating the position of the data to be retrieved
  @return data item found at position. If position is not a valid position < item_count_
  throws  PrecondViolatedExcep */
-template<class T>
-T LinkedList<T>::getEntry(int position) const
+template<class T, class Allocator>
+T LinkedList<T, Allocator>::getEntry(int position) const
 {
     // Enforce precondition
     bool ableToGet = (position >= 0) && (position < item_count_);
@@ -214,10 +282,20 @@ T LinkedList<T>::getEntry(int position) const
 // @param position the index of the desired node
 //       0 <= position < item_count_
 // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
-template<class T>
-Node<T>* LinkedList<T>::getNodeAt(int position) const
+template<class T, class Allocator>
+Node<T>* LinkedList<T, Allocator>::getNodeAt(int position) const
 {
-    // Count from the beginning of the chain
+    // Count from whichever end of the chain is closer
+    if (position >= item_count_ / 2)
+    {
+        if (position >= item_count_)
+            return nullptr;
+        Node<T>* cur_ptr = tail_ptr_;
+        for (int skip = item_count_ - 1; skip > position; skip--)
+            cur_ptr = cur_ptr->getPrevious();
+        return cur_ptr;
+    }  // end if
+
     Node<T>* cur_ptr = head_ptr_;
     for (int skip = 0; skip < position; skip++)
         cur_ptr = cur_ptr->getNext();
@@ -225,10 +303,56 @@ Node<T>* LinkedList<T>::getNodeAt(int position) const
     return cur_ptr;
 }  // end getNodeAt
 
+
+// Links a node into the chain before position_node, or at the end if position_node is nullptr,
+// and counts it
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::linkBefore(Node<T>* position_node, Node<T>* node)
+{
+   Node<T>* prev_ptr = (position_node == nullptr) ? tail_ptr_ : position_node->getPrevious();
+   node->setPrevious(prev_ptr);
+   node->setNext(position_node);
+
+   if (prev_ptr == nullptr)
+      head_ptr_ = node;
+   else
+      prev_ptr->setNext(node);
+
+   if (position_node == nullptr)
+      tail_ptr_ = node;
+   else
+      position_node->setPrevious(node);
+
+   item_count_++;  // Increase count of entries
+}  // end linkBefore
+
+
+// Unlinks a node from the chain and uncounts it, leaving it allocated
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::unlink(Node<T>* node)
+{
+   Node<T>* prev_ptr = node->getPrevious();
+   Node<T>* next_ptr = node->getNext();
+
+   if (prev_ptr == nullptr)
+      head_ptr_ = next_ptr;
+   else
+      prev_ptr->setNext(next_ptr);
+
+   if (next_ptr == nullptr)
+      tail_ptr_ = prev_ptr;
+   else
+      next_ptr->setPrevious(prev_ptr);
+
+   node->setNext(nullptr);
+   node->setPrevious(nullptr);
+   item_count_--;  // Decrease count of entries
+}  // end unlink
+
 //position follows classic indexing from 0 to item_count_-1
 //if position > item_count it returns nullptr
-template <class T>
-Node<T> *LinkedList<T>::getPointerTo(size_t position) const
+template<class T, class Allocator>
+Node<T> *LinkedList<T, Allocator>::getPointerTo(size_t position) const
 {
 
   Node<T> *find = nullptr;
@@ -248,12 +372,133 @@ Node<T> *LinkedList<T>::getPointerTo(size_t position) const
 
 
 //returns the head pointer
-template <class T>
-Node<T> *LinkedList<T>::getHeadNode() const
+template<class T, class Allocator>
+Node<T> *LinkedList<T, Allocator>::getHeadNode() const
 {
 
   return head_ptr_;
 } //end getHeadNode
 
 
+
+/**@return an iterator to the first entry, equal to end() if the list is empty */
+template<class T, class Allocator>
+typename LinkedList<T, Allocator>::iterator LinkedList<T, Allocator>::begin()
+{
+  return iterator(head_ptr_);
+} //end begin
+
+template<class T, class Allocator>
+typename LinkedList<T, Allocator>::const_iterator LinkedList<T, Allocator>::begin() const
+{
+  return const_iterator(head_ptr_);
+} //end begin
+
+template<class T, class Allocator>
+typename LinkedList<T, Allocator>::const_iterator LinkedList<T, Allocator>::cbegin() const
+{
+  return const_iterator(head_ptr_);
+} //end cbegin
+
+
+
+/**@return an iterator past the last entry */
+template<class T, class Allocator>
+typename LinkedList<T, Allocator>::iterator LinkedList<T, Allocator>::end()
+{
+  return iterator(nullptr);
+} //end end
+
+template<class T, class Allocator>
+typename LinkedList<T, Allocator>::const_iterator LinkedList<T, Allocator>::end() const
+{
+  return const_iterator(nullptr);
+} //end end
+
+template<class T, class Allocator>
+typename LinkedList<T, Allocator>::const_iterator LinkedList<T, Allocator>::cend() const
+{
+  return const_iterator(nullptr);
+} //end cend
+
+
+
+/**
+ @pre node is a node of this list
+ @post node is the first node of the list; it is relinked, not copied or reallocated. O(1) */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::moveToFront(Node<T>* node)
+{
+   if (node != head_ptr_)
+   {
+      unlink(node);
+      linkBefore(head_ptr_, node);
+   }  // end if
+}  // end moveToFront
+
+
+
+/**
+ @pre node is a node of this list
+ @post node is unlinked from the list and item_count_ is one less. The node is not freed: it still
+       belongs to this list's allocator and must be given back with reinsert. O(1)
+ @return node */
+template<class T, class Allocator>
+Node<T>* LinkedList<T, Allocator>::extract(Node<T>* node)
+{
+   unlink(node);
+   return node;
+}  // end extract
+
+
+
+/**
+ @pre node was returned by extract on this list; position_node is a node of this list or nullptr
+ @post node is linked in before position_node, or at the end if position_node is nullptr. O(1) */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::reinsert(Node<T>* position_node, Node<T>* node)
+{
+   linkBefore(position_node, node);
+}  // end reinsert
+
+
+
+/**
+ @pre position_node is a node of this list or nullptr
+ @post every node of a_list, in order, is linked in before position_node (at the end if nullptr), and
+       a_list is empty. The nodes are relinked, and this list's allocator takes over the memory
+       of a_list's nodes. O(1) apart from handing over the allocator's slabs */
+template<class T, class Allocator>
+void LinkedList<T, Allocator>::splice(Node<T>* position_node, LinkedList<T, Allocator>& a_list)
+{
+   if (&a_list == this || a_list.isEmpty())
+      return;
+
+   Node<T>* first_ptr = a_list.head_ptr_;
+   Node<T>* last_ptr = a_list.tail_ptr_;
+   Node<T>* prev_ptr = (position_node == nullptr) ? tail_ptr_ : position_node->getPrevious();
+
+   // Attach the first spliced node after prev_ptr
+   first_ptr->setPrevious(prev_ptr);
+   if (prev_ptr == nullptr)
+      head_ptr_ = first_ptr;
+   else
+      prev_ptr->setNext(first_ptr);
+
+   // Attach the last spliced node before position_node
+   last_ptr->setNext(position_node);
+   if (position_node == nullptr)
+      tail_ptr_ = last_ptr;
+   else
+      position_node->setPrevious(last_ptr);
+
+   item_count_ += a_list.item_count_;
+   allocator_.adopt(a_list.allocator_);
+
+   a_list.head_ptr_ = nullptr;
+   a_list.tail_ptr_ = nullptr;
+   a_list.item_count_ = 0;
+}  // end splice
+
+
 //  End of implementation file.
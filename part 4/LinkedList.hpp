@@ -6,7 +6,7 @@
 //  some style modification, mainly variable names 
 //  added getHeadNode() for grading purposes
 
-/** ADT list: Singly linked list implementation.
+/** ADT list: Doubly linked list implementation.
     Listing 9-2.
     @file LinkedList.h */
 
@@ -14,18 +14,78 @@
 #define LINKED_LIST_
 
 #include "Node.hpp"
+#include "NodePool.hpp"
 #include "PrecondViolatedExcep.hpp"
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 
-template<class T>
+// Allocator makes and frees the nodes; see NodePool.hpp
+template<class T, class Allocator = NodePool<T>>
 class LinkedList
 {
 
 public:
+   /** Forward iterator over the entries in list order; Item is T, or const T for const_iterator.
+       Dereferencing yields a reference into the node, so traversal neither walks from the head
+       per entry nor copies T. */
+   template<class Item>
+   class ListIterator
+   {
+   public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = Item*;
+      using reference = Item&;
+
+      ListIterator() : node_ptr_(nullptr) {}
+      explicit ListIterator(Node<T>* node_ptr) : node_ptr_(node_ptr) {}
+
+      // An iterator converts to a const_iterator
+      template<class Other, class = std::enable_if_t<std::is_same_v<Other, T> && std::is_const_v<Item>>>
+      ListIterator(const ListIterator<Other>& other) : node_ptr_(other.getNode()) {}
+
+      reference operator*() const { return node_ptr_->getItemRef(); }
+      pointer operator->() const { return &node_ptr_->getItemRef(); }
+
+      ListIterator& operator++()
+      {
+         node_ptr_ = node_ptr_->getNext();
+         return *this;
+      }
+
+      ListIterator operator++(int)
+      {
+         ListIterator previous = *this;
+         node_ptr_ = node_ptr_->getNext();
+         return previous;
+      }
+
+      bool operator==(const ListIterator& other) const { return node_ptr_ == other.node_ptr_; }
+      bool operator!=(const ListIterator& other) const { return node_ptr_ != other.node_ptr_; }
+
+      /**@return the node the iterator points to, nullptr at end() */
+      Node<T>* getNode() const { return node_ptr_; }
+
+   private:
+      Node<T>* node_ptr_;
+   }; // end ListIterator
+
+   using iterator = ListIterator<T>;
+   using const_iterator = ListIterator<const T>;
+
    LinkedList(); // constructor
-   LinkedList(const LinkedList<T>& a_list); // copy constructor
+   LinkedList(const LinkedList<T, Allocator>& a_list); // copy constructor
+   LinkedList(LinkedList<T, Allocator>&& a_list) noexcept; // move constructor: takes a_list's nodes in O(1)
+   LinkedList<T, Allocator>& operator=(LinkedList<T, Allocator> a_list); // copy-and-swap (and move) assignment
    virtual ~LinkedList(); // destructor
 
+   /**@post this list and a_list have exchanged their entries, in O(1) */
+   void swap(LinkedList<T, Allocator>& a_list) noexcept;
+
    /**@return true if list is empty - item_count_ == 0 */
    bool isEmpty() const;
 
@@ -40,6 +100,28 @@ public:
      @post new_entry is added at position in list (the node previously at that position is now at position+1)
      @return true if valid position (0 <= position <= item_count_) */
    bool insert(int position, const T& new_entry);
+   bool insert(int position, T&& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param args to construct the new entry from, in place in its node
+     @post the new entry is added at position in list
+     @return true if valid position (0 <= position <= item_count_) */
+   template<class... Args>
+   bool emplace(int position, Args&&... args);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is the last entry of the list; O(1) through tail_ptr_ */
+   void push_back(const T& new_entry);
+   void push_back(T&& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is the first entry of the list */
+   void push_front(const T& new_entry);
+   void push_front(T&& new_entry);
 
 
     /**
@@ -51,7 +133,9 @@ public:
 
 
 
-   /**@post the list is empty and item_count_ == 0*/
+   /**@post the list is empty and item_count_ == 0.
+      O(1) when the allocator can release all nodes at once (the default NodePool, for trivially
+      destructible T); otherwise the nodes are destroyed one by one */
    void clear();
 
 
@@ -67,6 +151,40 @@ public:
 
     Node<T> *getHeadNode() const;
 
+   /**@return an iterator to the first entry, equal to end() if the list is empty */
+   iterator begin();
+   const_iterator begin() const;
+   const_iterator cbegin() const;
+
+   /**@return an iterator past the last entry */
+   iterator end();
+   const_iterator end() const;
+   const_iterator cend() const;
+
+    /**
+     @pre node is a node of this list
+     @post node is the first node of the list; it is relinked, not copied or reallocated. O(1) */
+   void moveToFront(Node<T>* node);
+
+    /**
+     @pre node is a node of this list
+     @post node is unlinked from the list and item_count_ is one less. The node is not freed: it still
+           belongs to this list's allocator and must be given back with reinsert. O(1)
+     @return node */
+   Node<T>* extract(Node<T>* node);
+
+    /**
+     @pre node was returned by extract on this list; position_node is a node of this list or nullptr
+     @post node is linked in before position_node, or at the end if position_node is nullptr. O(1) */
+   void reinsert(Node<T>* position_node, Node<T>* node);
+
+    /**
+     @pre position_node is a node of this list or nullptr
+     @post every node of a_list, in order, is linked in before position_node (at the end if nullptr), and
+           a_list is empty. The nodes are relinked, and this list's allocator takes over the memory
+           of a_list's nodes. O(1) apart from handing over the allocator's slabs */
+   void splice(Node<T>* position_node, LinkedList<T, Allocator>& a_list);
+
 
 
 
@@ -74,7 +192,9 @@ public:
 protected:
     Node<T>* head_ptr_; // Pointer to first node in the chain;
     // (contains the first entry in the list)
+    Node<T>* tail_ptr_; // Pointer to last node in the chain, nullptr if empty
     int item_count_;           // Current count of list items
+    Allocator allocator_;      // Makes and frees the nodes of this list only
 
 
 
@@ -85,6 +205,13 @@ protected:
     // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
     Node<T>* getNodeAt(int position) const;
 
+    // Links a node into the chain before position_node, or at the end if position_node is nullptr,
+    // and counts it
+    void linkBefore(Node<T>* position_node, Node<T>* node);
+
+    // Unlinks a node from the chain and uncounts it, leaving it allocated
+    void unlink(Node<T>* node);
+
 
 
 
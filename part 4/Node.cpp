@@ -3,7 +3,7 @@
 //  Modified by Tiziana Ligorio 
 
 /** @file Node.cpp
- Node for Singly Linked List*/
+ Node for Doubly Linked List*/
 
 
 #include "Node.hpp"
@@ -11,21 +11,35 @@
 
 //default constructor
 template<class T>
-Node<T>::Node() : next_(nullptr)
+Node<T>::Node() : next_(nullptr), previous_(nullptr)
 {
 } // end default constructor
 
 
 //parameterized constructor
 template<class T>
-Node<T>::Node(const T& an_item) : item_(an_item), next_(nullptr)
+Node<T>::Node(const T& an_item) : item_(an_item), next_(nullptr), previous_(nullptr)
+{
+} // end constructor
+
+//moves an_item into the node
+template<class T>
+Node<T>::Node(T&& an_item) : item_(std::move(an_item)), next_(nullptr), previous_(nullptr)
+{
+} // end constructor
+
+// constructs item_ in place from args
+template<class T>
+template<class... Args>
+Node<T>::Node(std::in_place_t, Args&&... args) :
+                item_(std::forward<Args>(args)...), next_(nullptr), previous_(nullptr)
 {
 } // end constructor
 
 //parameterized constructor
 template<class T>
 Node<T>::Node(const T& an_item, Node<T>* next_node_ptr) :
-                item_(an_item), next_(next_node_ptr)
+                item_(an_item), next_(next_node_ptr), previous_(nullptr)
 {
 } // end constructor
 
@@ -47,6 +61,15 @@ void Node<T>::setNext(Node<T>* next_node_ptr)
    next_ = next_node_ptr;
 } // end setNext
 
+
+/** @param previous_node_ptr points to the previous node in the chain
+ @post sets previous_ to previous_node_ptr */
+template<class T>
+void Node<T>::setPrevious(Node<T>* previous_node_ptr)
+{
+   previous_ = previous_node_ptr;
+} // end setPrevious
+
  /**@return item_*/
 template<class T>
 T Node<T>::getItem() const
@@ -54,9 +77,29 @@ T Node<T>::getItem() const
    return item_;
 } // end getItem
 
+/**@return a reference to item_, to read or update it in place without a copy*/
+template<class T>
+T& Node<T>::getItemRef()
+{
+   return item_;
+} // end getItemRef
+
+template<class T>
+const T& Node<T>::getItemRef() const
+{
+   return item_;
+} // end getItemRef
+
  /**@return next_*/
 template<class T>
 Node<T>* Node<T>::getNext() const
 {
    return next_;
 } // end getNext
+
+ /**@return previous_*/
+template<class T>
+Node<T>* Node<T>::getPrevious() const
+{
+   return previous_;
+} // end getPrevious
@@ -3,11 +3,13 @@
 //  Modified by Tiziana Ligorio 
 
 /** @file Node.hpp
-    Node for Singly Linked Chain*/
+    Node for Doubly Linked Chain*/
 
 #ifndef NODE_
 #define NODE_
 
+#include <utility>
+
 template<class T>
 class Node
 {
@@ -15,6 +17,11 @@ public:
    Node();  //default constructor
    Node(const T& an_item); //parameterized constructor
    Node(const T& an_item, Node<T>* next_node_ptr); //parameterized constructor
+   Node(T&& an_item); //moves an_item into the node
+
+   // constructs item_ in place from args
+   template<class... Args>
+   explicit Node(std::in_place_t, Args&&... args);
 
    /** @param an_item  contained in the node
         @post sets item_ to an_item */
@@ -23,16 +30,28 @@ public:
     /** @param next_node_ptr points to the next node in the chain
      @post sets next_ to next_node_ptr */
    void setNext(Node<T>* next_node_ptr);
+
+    /** @param previous_node_ptr points to the previous node in the chain
+     @post sets previous_ to previous_node_ptr */
+   void setPrevious(Node<T>* previous_node_ptr);
     
     /**@return item_*/
    T getItem() const ;
+
+    /**@return a reference to item_, to read or update it in place without a copy*/
+   T& getItemRef();
+   const T& getItemRef() const;
     
     /**@return next_*/
    Node<T>* getNext() const ;
+
+    /**@return previous_*/
+   Node<T>* getPrevious() const ;
     
 private:
     T        item_; // A data item_
     Node<T>* next_; // Pointer to next_ node
+    Node<T>* previous_; // Pointer to previous_ node
 }; // end Node
 
 #include "Node.cpp"
@@ -0,0 +1,164 @@
+/** Header file for the node allocators of LinkedList. NodePool, the default, carves nodes out of slabs and keeps
+    freed nodes on a free list, so inserting after a remove reuses the removed node instead of calling new.
+    HeapNodeAllocator allocates every node with new and frees it with delete.
+
+    An allocator provides:
+      Node<T>* create(Args&&... args) constructs a node whose item is made from args
+      void destroy(Node<T>* node)     destroys a node made by create
+      bool release()                  destroys every node at once if it can, returning false if the list
+                                      has to destroy its nodes one by one instead
+      void adopt(Allocator& other)    takes over the nodes made by other, when LinkedList::splice moves
+                                      them into this allocator's list
+      void swap(Allocator& other)     exchanges nodes with other, when lists are moved or swapped **/
+
+#ifndef NODEPOOL_HPP
+#define NODEPOOL_HPP
+
+#include "Node.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template<class T>
+class NodePool
+{
+public:
+    NodePool() : slab_(0), used_(0), free_list_(nullptr) {}
+
+    // Every list owns its own pool, so a pool is never copied along with a list; moving a list moves its pool
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept : NodePool()
+    {
+        swap(other);
+    }
+
+    template<class... Args>
+    Node<T>* create(Args&&... args)
+    {
+        Slot* slot = free_list_;
+        if (slot != nullptr) {
+            free_list_ = slot->next;
+        } else {
+            slot = takeSlot();
+        }
+        return new (slot->storage) Node<T>(std::in_place, std::forward<Args>(args)...);
+    }
+
+    void destroy(Node<T>* node)
+    {
+        node->~Node<T>();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = free_list_;
+        free_list_ = slot;
+    }
+
+    // Frees every node in O(1) by rewinding the slabs, which are kept for the next inserts.
+    // Nodes whose item needs a destructor have to be destroyed one by one, so this returns false for them.
+    bool release()
+    {
+        if (!std::is_trivially_destructible_v<T>) {
+            return false;
+        }
+        slab_ = 0;
+        used_ = 0;
+        free_list_ = nullptr;
+        adopted_.clear();
+        return true;
+    }
+
+    void swap(NodePool& other) noexcept
+    {
+        slabs_.swap(other.slabs_);
+        slab_sizes_.swap(other.slab_sizes_);
+        adopted_.swap(other.adopted_);
+        std::swap(slab_, other.slab_);
+        std::swap(used_, other.used_);
+        std::swap(free_list_, other.free_list_);
+    }
+
+    // Takes ownership of other's slabs so its nodes outlive it. Their unused slots are not reused.
+    void adopt(NodePool& other)
+    {
+        for (std::unique_ptr<Slot[]>& slab : other.slabs_) {
+            adopted_.push_back(std::move(slab));
+        }
+        for (std::unique_ptr<Slot[]>& slab : other.adopted_) {
+            adopted_.push_back(std::move(slab));
+        }
+        other.slabs_.clear();
+        other.slab_sizes_.clear();
+        other.adopted_.clear();
+        other.slab_ = 0;
+        other.used_ = 0;
+        other.free_list_ = nullptr;
+    }
+
+private:
+    // Storage for one node; while the node is free the same bytes link it into the free list
+    union Slot {
+        Slot* next;
+        alignas(Node<T>) unsigned char storage[sizeof(Node<T>)];
+    };
+
+    static constexpr size_t FIRST_SLAB = 16;
+    static constexpr size_t MAX_SLAB = 4096;
+
+    // Takes the next never-used slot, adding a slab twice the size of the last one when all are used
+    Slot* takeSlot()
+    {
+        while (slab_ < slabs_.size() && used_ == slab_sizes_[slab_]) {
+            slab_++;
+            used_ = 0;
+        }
+        if (slab_ == slabs_.size()) {
+            size_t size = slab_sizes_.empty() ? FIRST_SLAB : std::min(slab_sizes_.back() * 2, MAX_SLAB);
+            slabs_.push_back(std::make_unique<Slot[]>(size));
+            slab_sizes_.push_back(size);
+        }
+        return &slabs_[slab_][used_++];
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    std::vector<size_t> slab_sizes_;
+    size_t slab_;       // Slab the next never-used slot comes from
+    size_t used_;       // Slots of that slab handed out since it was reached
+    Slot* free_list_;   // Destroyed nodes, most recent first
+    std::vector<std::unique_ptr<Slot[]>> adopted_;  // Slabs taken over from other pools, freed on release
+};
+
+template<class T>
+class HeapNodeAllocator
+{
+public:
+    template<class... Args>
+    Node<T>* create(Args&&... args)
+    {
+        return new Node<T>(std::in_place, std::forward<Args>(args)...);
+    }
+
+    void destroy(Node<T>* node)
+    {
+        delete node;
+    }
+
+    bool release()
+    {
+        return false;
+    }
+
+    void adopt(HeapNodeAllocator&)
+    {
+    }
+
+    void swap(HeapNodeAllocator&) noexcept
+    {
+    }
+};
+
+#endif
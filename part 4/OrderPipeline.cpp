@@ -0,0 +1,346 @@
+// OrderPipeline.cpp contains the coroutine executor and the staged order coroutines of the OrderPipeline.
+#include "OrderPipeline.hpp"
+#include <stdexcept>
+#include <unordered_set>
+
+// Executor
+PipelineExecutor::PipelineExecutor(size_t worker_threads) : running_(0), stopping_(false) {
+    for (size_t i = 0; i < worker_threads; ++i) {
+        workers_.emplace_back(&PipelineExecutor::work, this);
+    }
+}
+
+PipelineExecutor::~PipelineExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_cv_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void PipelineExecutor::post(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_.push_back(handle);
+    }
+    ready_cv_.notify_one();
+}
+
+// Resumes the oldest queued coroutine without holding the lock; returns false if none is queued
+bool PipelineExecutor::resumeOne(std::unique_lock<std::mutex>& lock) {
+    if (ready_.empty()) {
+        return false;
+    }
+    std::coroutine_handle<> handle = ready_.front();
+    ready_.pop_front();
+    running_++;
+    lock.unlock();
+    handle.resume();
+    lock.lock();
+    running_--;
+    if (running_ == 0 && ready_.empty()) {
+        idle_cv_.notify_all();
+    }
+    return true;
+}
+
+void PipelineExecutor::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        if (resumeOne(lock)) {
+            continue;
+        }
+        if (running_ == 0) {
+            return;
+        }
+        // A worker is running a coroutine that may queue more work
+        idle_cv_.wait(lock, [this] { return !ready_.empty() || running_ == 0; });
+    }
+}
+
+void PipelineExecutor::work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        ready_cv_.wait(lock, [this] { return stopping_ || !ready_.empty(); });
+        if (stopping_) {
+            return;
+        }
+        resumeOne(lock);
+    }
+}
+
+// Pipeline
+OrderPipeline::OrderPipeline(StationManager& manager, PipelineExecutor& executor, int station_slots, int cook_steps)
+    : manager_(manager), executor_(executor), station_slots_(std::max(station_slots, 1)), cook_steps_(std::max(cook_steps, 0)),
+      stock_version_(0), in_flight_(0), in_flight_high_water_(0), completed_(0) {
+}
+
+OrderPipeline::~OrderPipeline() {
+    drain();
+}
+
+void OrderPipeline::submit(Dish* dish) {
+    start(dish, false, Dish::DietaryRequest());
+}
+
+void OrderPipeline::submit(Dish* dish, const Dish::DietaryRequest& request) {
+    start(dish, true, request);
+}
+
+void OrderPipeline::start(Dish* dish, bool accommodate, const Dish::DietaryRequest& request) {
+    if (!dish) {
+        throw std::invalid_argument("Dish pointer must not be null.");
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_++;
+        in_flight_high_water_ = std::max(in_flight_high_water_, in_flight_);
+    }
+    executor_.post(runOrder(dish, accommodate, request).handle);
+}
+
+void OrderPipeline::setCompletionHandler(CompletionHandler handler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    on_complete_ = std::move(handler);
+}
+
+// One order from intake to completion; the mutex is never held across a suspension
+OrderPipeline::OrderTask OrderPipeline::runOrder(Dish* dish, bool accommodate, Dish::DietaryRequest request) {
+    const std::string dish_name = dish->getName();
+
+    // Intake
+    OrderTracer::beginOrder(dish);
+
+    // Dietary accommodation
+    if (accommodate) {
+        OrderTracer::Scope trace("accommodation", dish, dish);
+        dish->dietaryAccommodations(request);
+    }
+
+    std::string station_name;
+    while (true) {
+        // Routing, with replenishment from backup when no carrier has stock
+        uint64_t stock_version;
+        bool carried = false;
+        {
+            OrderTracer::Scope trace("routing", dish, dish);
+            std::lock_guard<std::mutex> lock(mutex_);
+            KitchenStation* station = routeOrder(dish_name, carried);
+            station_name = station != nullptr ? station->getName() : "";
+            stock_version = stock_version_;
+            if (!carried) {
+                // No station carries the dish: leave it in the manager's queue like any unprepared dish
+                manager_.addDishToQueue(dish);
+                in_flight_--;
+                co_return;
+            }
+        }
+        if (station_name.empty()) {
+            co_await StockWait{this, dish, stock_version};
+            continue;
+        }
+
+        // Preparation: hold a station slot while the dish cooks; the station is looked up by name under the
+        // mutex, so one removed or merged away while the order waited just fails and the order routes again
+        co_await SlotWait{this, station_name};
+        bool prepared;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            prepared = manager_.prepareDishAtStation(station_name, dish_name);
+            if (!prepared) {
+                releaseSlot(station_name); // Another order took the stock while this one waited for the slot
+            }
+        }
+        if (!prepared) {
+            continue;
+        }
+        for (int step = 0; step < cook_steps_; ++step) {
+            co_await executor_.yield();
+        }
+
+        // Completion
+        CompletionHandler on_complete;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            releaseSlot(station_name);
+            on_complete = on_complete_;
+            in_flight_--;
+            completed_++;
+        }
+        OrderTracer::completeOrder(dish);
+        if (on_complete) {
+            on_complete(*dish, station_name);
+        }
+        delete dish;
+        co_return;
+    }
+}
+
+KitchenStation* OrderPipeline::routeOrder(const std::string& dish_name, bool& carried) {
+    KitchenStation* best = nullptr;
+    int best_servings = 0;
+    std::vector<KitchenStation*> carriers;
+    for (KitchenStation* station : manager_) {
+        if (station->getDish(dish_name) == nullptr) {
+            continue;
+        }
+        carriers.push_back(station);
+        int servings = station->servingsAvailable(dish_name);
+        if (servings > best_servings) {
+            best = station;
+            best_servings = servings;
+        }
+    }
+    carried = !carriers.empty();
+    if (best != nullptr) {
+        return best;
+    }
+
+    // Replenishment
+    for (KitchenStation* station : carriers) {
+        OrderTracer::Scope trace("replenishment", nullptr, station);
+        if (manager_.replenishForDish(station->getName(), dish_name)) {
+            return station;
+        }
+    }
+    return nullptr;
+}
+
+// Parks the order under every ingredient some carrier lacks even with the backup stock
+bool OrderPipeline::StockWait::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(pipeline->mutex_);
+    if (pipeline->stock_version_ != stock_version) {
+        return false; // Stock changed since routing; route again
+    }
+    std::unordered_set<std::string> missing;
+    const std::string dish_name = dish->getName();
+    for (KitchenStation* station : pipeline->manager_) {
+        Dish* station_dish = station->getDish(dish_name);
+        if (station_dish == nullptr) {
+            continue;
+        }
+        std::vector<Ingredient> stock = station->getIngredientsStock();
+        for (const Ingredient& ingredient : station_dish->getIngredients()) {
+            int total = pipeline->manager_.getBackupQuantity(ingredient.name);
+            for (const Ingredient& stock_ingredient : stock) {
+                if (stock_ingredient.name == ingredient.name) {
+                    total += stock_ingredient.quantity;
+                    break;
+                }
+            }
+            if (total < ingredient.required_quantity) {
+                missing.insert(ingredient.name);
+            }
+        }
+    }
+    if (missing.empty()) {
+        return false;
+    }
+
+    std::shared_ptr<StockWaiter> waiter = std::make_shared<StockWaiter>(StockWaiter{handle, dish, false});
+    for (const std::string& ingredient_name : missing) {
+        pipeline->stock_waiters_[ingredient_name].push_back(waiter);
+    }
+    pipeline->parked_.emplace(handle.address(), waiter);
+    return true;
+}
+
+bool OrderPipeline::SlotWait::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(pipeline->mutex_);
+    auto found = pipeline->slots_.find(station_name);
+    if (found == pipeline->slots_.end()) {
+        found = pipeline->slots_.emplace(station_name, StationSlots{pipeline->station_slots_, {}}).first;
+    }
+    if (found->second.free > 0) {
+        found->second.free--;
+        return false;
+    }
+    found->second.waiters.push_back(handle);
+    return true;
+}
+
+// The slot passes straight to the next waiter, so a released slot is never taken twice
+void OrderPipeline::releaseSlot(const std::string& station_name) {
+    StationSlots& slots = slots_[station_name];
+    if (!slots.waiters.empty()) {
+        executor_.post(slots.waiters.front());
+        slots.waiters.pop_front();
+    } else {
+        slots.free++;
+    }
+}
+
+void OrderPipeline::wakeStockWaiters(const std::string& ingredient_name) {
+    stock_version_++;
+    auto found = stock_waiters_.find(ingredient_name);
+    if (found == stock_waiters_.end()) {
+        return;
+    }
+    std::vector<std::shared_ptr<StockWaiter>> waiters;
+    waiters.swap(found->second);
+    stock_waiters_.erase(found);
+    for (const std::shared_ptr<StockWaiter>& waiter : waiters) {
+        // A waiter listed under several ingredients is woken once; its other entries are dropped when met
+        if (!waiter->woken) {
+            waiter->woken = true;
+            parked_.erase(waiter->handle.address());
+            executor_.post(waiter->handle);
+        }
+    }
+}
+
+bool OrderPipeline::addBackupIngredient(const Ingredient& ingredient) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool added = manager_.addBackupIngredient(ingredient);
+    if (added) {
+        wakeStockWaiters(ingredient.name);
+    }
+    return added;
+}
+
+bool OrderPipeline::replenishIngredientAtStation(const std::string& station_name, const Ingredient& ingredient) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool replenished = manager_.replenishIngredientAtStation(station_name, ingredient);
+    if (replenished) {
+        wakeStockWaiters(ingredient.name);
+    }
+    return replenished;
+}
+
+size_t OrderPipeline::drain() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t moved = parked_.size();
+    for (auto& entry : parked_) {
+        StockWaiter& waiter = *entry.second;
+        waiter.woken = true;
+        manager_.addDishToQueue(waiter.dish);
+        waiter.handle.destroy();
+        in_flight_--;
+    }
+    parked_.clear();
+    stock_waiters_.clear();
+    return moved;
+}
+
+size_t OrderPipeline::getInFlightCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+size_t OrderPipeline::getWaitingForStockCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return parked_.size();
+}
+
+long OrderPipeline::getCompletedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_;
+}
+
+size_t OrderPipeline::getInFlightHighWater() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_high_water_;
+}
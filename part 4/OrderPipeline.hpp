@@ -0,0 +1,244 @@
+/** Header file for the OrderPipeline, which runs every submitted order as a C++20 coroutine through the stages
+    intake, dietary accommodation, routing, replenishment, preparation and completion. An order that waits for
+    stock or for a free station slot suspends instead of polling, so thousands of orders can be in flight on a
+    PipelineExecutor with one or a few threads. **/
+
+#ifndef ORDERPIPELINE_HPP
+#define ORDERPIPELINE_HPP
+
+#include "StationManager.hpp"
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class PipelineExecutor {
+
+public:
+    /**
+     * @param worker_threads Threads that run coroutines besides the one calling run(); 0 runs everything in run().
+     */
+    explicit PipelineExecutor(size_t worker_threads = 0);
+
+    /**
+     * Stops the worker threads. Coroutines still queued are not resumed.
+     */
+    ~PipelineExecutor();
+
+    PipelineExecutor(const PipelineExecutor&) = delete;
+    PipelineExecutor& operator=(const PipelineExecutor&) = delete;
+
+    /**
+     * Queues a suspended coroutine to be resumed.
+     */
+    void post(std::coroutine_handle<> handle);
+
+    /**
+     * Resumes queued coroutines on the calling thread (and the workers) until none is queued or running.
+     * Coroutines suspended on something other than the executor stay suspended.
+     */
+    void run();
+
+    /**
+     * Awaitable that suspends the current coroutine and queues it again, letting other coroutines run.
+     */
+    struct Yield {
+        PipelineExecutor* executor;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const { executor->post(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    Yield yield() { return Yield{this}; }
+
+private:
+    void work();
+    bool resumeOne(std::unique_lock<std::mutex>& lock);
+
+    std::mutex mutex_;
+    std::condition_variable ready_cv_;  ///< Signalled when a coroutine is queued
+    std::condition_variable idle_cv_;   ///< Signalled when the last running coroutine suspends
+    std::deque<std::coroutine_handle<>> ready_;
+    size_t running_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+};
+
+class OrderPipeline {
+
+public:
+    /**
+     * Called when an order completes, with the dish and the station that prepared it; the dish is deleted after.
+     */
+    using CompletionHandler = std::function<void(const Dish& dish, const std::string& station_name)>;
+
+    /**
+     * @param manager The stations, backup stock and write-ahead log the orders use. While orders are in flight,
+     * change stock only through this pipeline so waiting orders are woken, and add, remove or merge stations
+     * only while executor.run() is not running. Orders hold station slots by name: an order whose station was
+     * removed or merged away routes again.
+     * @param executor Runs the order coroutines.
+     * @param station_slots Orders a station prepares at the same time; later orders wait for a free slot.
+     * @param cook_steps Executor turns an order keeps its station slot after the stock is taken.
+     */
+    OrderPipeline(StationManager& manager, PipelineExecutor& executor, int station_slots = 2, int cook_steps = 1);
+
+    /**
+     * Hands every order still waiting for stock to the manager's queue (see drain()).
+     * @pre: executor.run() has returned, so no order is queued or running.
+     */
+    ~OrderPipeline();
+
+    OrderPipeline(const OrderPipeline&) = delete;
+    OrderPipeline& operator=(const OrderPipeline&) = delete;
+
+    /**
+     * Starts an order. The pipeline owns the dish until it completes or is handed to the manager's queue.
+     * @param dish A dynamically allocated dish.
+     * @throws std::invalid_argument if dish is null.
+     */
+    void submit(Dish* dish);
+
+    /**
+     * Starts an order whose dish is adjusted for dietary accommodations in the accommodation stage.
+     */
+    void submit(Dish* dish, const Dish::DietaryRequest& request);
+
+    void setCompletionHandler(CompletionHandler handler);
+
+    /**
+     * StationManager::addBackupIngredient, then wakes the orders waiting for that ingredient.
+     */
+    bool addBackupIngredient(const Ingredient& ingredient);
+
+    /**
+     * StationManager::replenishIngredientAtStation, then wakes the orders waiting for that ingredient.
+     */
+    bool replenishIngredientAtStation(const std::string& station_name, const Ingredient& ingredient);
+
+    /**
+     * Moves every order waiting for stock into the manager's queue with addDishToQueue, where
+     * processAllDishes can retry it, and ends its coroutine.
+     * @pre: No order is queued or running on the executor.
+     * @return: The number of orders moved.
+     */
+    size_t drain();
+
+    /**
+     * @return: Orders submitted and neither completed nor moved to the manager's queue.
+     */
+    size_t getInFlightCount() const;
+
+    /**
+     * @return: Orders suspended until an ingredient they lack is replenished.
+     */
+    size_t getWaitingForStockCount() const;
+
+    /**
+     * @return: Orders completed so far.
+     */
+    long getCompletedCount() const;
+
+    /**
+     * @return: The largest number of orders in flight at once.
+     */
+    size_t getInFlightHighWater() const;
+
+private:
+    /**
+     * Coroutine type of one order; it starts suspended and is posted to the executor by submit().
+     */
+    struct OrderTask {
+        struct promise_type {
+            OrderTask get_return_object() { return OrderTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    /**
+     * An order suspended until one of the ingredients it lacks is replenished.
+     */
+    struct StockWaiter {
+        std::coroutine_handle<> handle;
+        Dish* dish;
+        bool woken;
+    };
+
+    /**
+     * Suspends an order until stock it lacks changes, unless stock changed since stock_version was read.
+     */
+    struct StockWait {
+        OrderPipeline* pipeline;
+        Dish* dish;
+        uint64_t stock_version;
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * Free slots of a station and the orders waiting for one, in arrival order.
+     */
+    struct StationSlots {
+        int free;
+        std::deque<std::coroutine_handle<>> waiters;
+    };
+
+    /**
+     * Suspends an order until it holds a slot of the named station.
+     */
+    struct SlotWait {
+        OrderPipeline* pipeline;
+        const std::string& station_name; ///< The order's frame owns it; a std::string member miscompiles with GCC 12
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+    };
+
+    OrderTask runOrder(Dish* dish, bool accommodate, Dish::DietaryRequest request);
+
+    void start(Dish* dish, bool accommodate, const Dish::DietaryRequest& request);
+
+    /**
+     * @return: The station carrying the dish that can serve it from its own stock with the most servings, or
+     * after replenishing from backup; nullptr if no station can. Call with mutex_ held.
+     */
+    KitchenStation* routeOrder(const std::string& dish_name, bool& carried);
+
+    /**
+     * Gives a station slot to the next waiting order, or frees it. Call with mutex_ held.
+     */
+    void releaseSlot(const std::string& station_name);
+
+    /**
+     * Wakes the orders waiting for an ingredient. Call with mutex_ held.
+     */
+    void wakeStockWaiters(const std::string& ingredient_name);
+
+    StationManager& manager_;
+    PipelineExecutor& executor_;
+    int station_slots_;
+    int cook_steps_;
+    CompletionHandler on_complete_;
+
+    mutable std::mutex mutex_; ///< Guards the manager and every member below while orders run on several threads
+    uint64_t stock_version_; ///< Incremented on every stock change through this pipeline
+    std::unordered_map<std::string, std::vector<std::shared_ptr<StockWaiter>>> stock_waiters_; ///< By missing ingredient
+    std::unordered_map<void*, std::shared_ptr<StockWaiter>> parked_; ///< Every order waiting for stock, by frame
+    std::unordered_map<std::string, StationSlots> slots_; ///< By station name, so no station pointer outlives the mutex
+    size_t in_flight_;
+    size_t in_flight_high_water_;
+    long completed_;
+};
+
+#endif
@@ -0,0 +1,136 @@
+// OrderTracer.cpp contains the per-thread ring buffers of the OrderTracer and the Chrome trace_event export.
+#include "OrderTracer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+// Single-producer ring: only its thread writes, export reads the published prefix
+struct Ring {
+    std::vector<OrderTracer::Event> events;
+    std::atomic<uint64_t> head{0}; ///< Events ever written; slot = head % capacity
+    int tid;
+
+    explicit Ring(int thread_id) : events(OrderTracer::RING_CAPACITY), tid(thread_id) {}
+};
+
+std::mutex rings_mutex;
+std::vector<std::shared_ptr<Ring>> rings; // Rings outlive their threads so their events can still be exported
+
+Ring& threadRing() {
+    thread_local std::shared_ptr<Ring> ring;
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        ring = std::make_shared<Ring>(static_cast<int>(rings.size()) + 1);
+        rings.push_back(ring);
+    }
+    return *ring;
+}
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+void appendJsonString(std::ostringstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            out << ' ';
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+std::atomic<bool> OrderTracer::enabled_(false);
+
+// Turns tracing on or off for every thread
+void OrderTracer::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+// Nanoseconds since the tracer epoch
+uint64_t OrderTracer::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+// Appends an event to the calling thread's ring, overwriting the oldest one when full
+void OrderTracer::record(char phase, const char* stage, const void* order, const std::string& label,
+                         uint64_t start_ns, uint64_t duration_ns) {
+    Ring& ring = threadRing();
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    Event& event = ring.events[head % RING_CAPACITY];
+    event.phase = phase;
+    event.stage = stage;
+    event.order = reinterpret_cast<uintptr_t>(order);
+    event.start_ns = start_ns;
+    event.duration_ns = duration_ns;
+    size_t length = std::min(label.size(), sizeof(event.label) - 1);
+    std::memcpy(event.label, label.data(), length);
+    event.label[length] = '\0';
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+// Exports every ring as Chrome trace_event JSON
+std::string OrderTracer::chromeTraceJson() {
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    for (const std::shared_ptr<Ring>& ring : rings) {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+        for (uint64_t i = begin; i < head; ++i) {
+            const Event& event = ring->events[i % RING_CAPACITY];
+            char timestamp[64];
+            std::snprintf(timestamp, sizeof(timestamp), "%.3f", event.start_ns / 1000.0);
+            out << (first ? "\n" : ",\n") << "{\"name\": ";
+            appendJsonString(out, event.stage);
+            out << ", \"cat\": \"order\", \"ph\": \"" << event.phase << "\", \"ts\": " << timestamp
+                << ", \"pid\": 1, \"tid\": " << ring->tid;
+            if (event.phase == 'X') {
+                std::snprintf(timestamp, sizeof(timestamp), "%.3f", event.duration_ns / 1000.0);
+                out << ", \"dur\": " << timestamp;
+            } else if (event.phase == 'i') {
+                out << ", \"s\": \"t\"";
+            } else {
+                out << ", \"id\": \"0x" << std::hex << event.order << std::dec << "\"";
+            }
+            out << ", \"args\": {\"order\": \"0x" << std::hex << event.order << std::dec << "\", \"label\": ";
+            appendJsonString(out, event.label);
+            out << "}}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+// Writes the Chrome trace to a file
+bool OrderTracer::writeChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+    file << chromeTraceJson();
+    return static_cast<bool>(file);
+}
+
+// Drops every buffered event
+void OrderTracer::clear() {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    for (const std::shared_ptr<Ring>& ring : rings) {
+        ring->head.store(0, std::memory_order_release);
+    }
+}
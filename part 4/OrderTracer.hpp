@@ -0,0 +1,137 @@
+/** Header file for the OrderTracer, an optional per-order latency tracer. Each thread records trace events
+    into its own fixed-size ring buffer without locks; the buffers are exported as Chrome trace_event JSON
+    that loads in chrome://tracing or Perfetto. When tracing is off, a trace point costs one relaxed load. **/
+
+#ifndef ORDERTRACER_HPP
+#define ORDERTRACER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class OrderTracer {
+
+public:
+    /// Events each thread keeps; older events are overwritten.
+    static const size_t RING_CAPACITY = 1 << 16;
+
+    /**
+     * One trace record. order is an opaque id (the queued Dish pointer), 0 when unknown.
+     */
+    struct Event {
+        char phase;          ///< 'X' complete span, 'i' instant, 'b'/'e' begin/end of the order's async span
+        const char* stage;   ///< Static stage name
+        uint64_t order;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+        char label[40];      ///< Dish or station name, truncated
+    };
+
+    /**
+     * Turns tracing on or off for every thread. Events already recorded are kept.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @return: True if trace points record events.
+     */
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @return: Nanoseconds since the tracer was first used.
+     */
+    static uint64_t now();
+
+    /**
+     * Records an event in the calling thread's ring buffer. Call only when isEnabled().
+     */
+    static void record(char phase, const char* stage, const void* order, const std::string& label,
+                       uint64_t start_ns, uint64_t duration_ns);
+
+    /**
+     * Marks the start of an order's life (its async span) if tracing is on.
+     * @param order The queued dish; its getName() is only called when tracing.
+     */
+    template <typename Order>
+    static void beginOrder(const Order* order) {
+        if (isEnabled()) {
+            record('b', "order", order, order->getName(), now(), 0);
+        }
+    }
+
+    /**
+     * Marks the completion of an order: an instant event and the end of its async span, if tracing is on.
+     */
+    template <typename Order>
+    static void completeOrder(const Order* order) {
+        if (isEnabled()) {
+            uint64_t at = now();
+            std::string label = order->getName();
+            record('i', "completion", order, label, at, 0);
+            record('e', "order", order, label, at, 0);
+        }
+    }
+
+    /**
+     * Writes every buffered event as Chrome trace_event JSON. Call while no thread is recording.
+     * @return: The JSON document.
+     */
+    static std::string chromeTraceJson();
+
+    /**
+     * Writes chromeTraceJson() to a file.
+     * @return: True if the file was written; false otherwise.
+     */
+    static bool writeChromeTrace(const std::string& filename);
+
+    /**
+     * Drops every buffered event. Call while no thread is recording.
+     */
+    static void clear();
+
+    /**
+     * Times a scope as one 'X' span if tracing was on when the scope began.
+     */
+    class Scope {
+    public:
+        Scope(const char* stage, const void* order, std::string_view label)
+            : active_(isEnabled()), stage_(stage), order_(order), start_(0) {
+            if (active_) {
+                label_ = label;
+                start_ = now();
+            }
+        }
+
+        /**
+         * Labels the span with named->getName(), which is only called when tracing.
+         */
+        template <typename Named>
+        Scope(const char* stage, const void* order, const Named* named)
+            : active_(isEnabled()), stage_(stage), order_(order), start_(0) {
+            if (active_) {
+                label_ = named->getName();
+                start_ = now();
+            }
+        }
+        ~Scope() {
+            if (active_) {
+                record('X', stage_, order_, label_, start_, now() - start_);
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool active_;
+        const char* stage_;
+        const void* order_;
+        std::string label_;
+        uint64_t start_;
+    };
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+#endif
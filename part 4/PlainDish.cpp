@@ -0,0 +1,46 @@
+#include "PlainDish.hpp"
+#include <iomanip>
+#include <iostream>
+
+/**
+ * Default constructor.
+ */
+PlainDish::PlainDish() : Dish() {}
+
+/**
+ * Parameterized constructor.
+ * @param name The name of the dish.
+ * @param ingredients The ingredients used in the dish.
+ * @param prep_time The preparation time in minutes.
+ * @param price The price of the dish.
+ * @param cuisine_type The cuisine type of the dish.
+ */
+PlainDish::PlainDish(const std::string& name, const std::vector<Ingredient>& ingredients, int prep_time, double price, CuisineType cuisine_type)
+    : Dish(name, ingredients, prep_time, price, cuisine_type) {}
+
+/**
+ * Displays the dish's name, ingredients, preparation time, price and cuisine type.
+ */
+void PlainDish::display() const
+{
+    std::cout << "Dish Name: " << getName() << std::endl;
+    std::cout << "Ingredients: ";
+    for (size_t i = 0; i < getIngredients().size(); ++i) {
+        std::cout << getIngredients()[i].name;
+        if (i != getIngredients().size() - 1) {
+            std::cout << ", ";
+        }
+    }
+    std::cout << std::endl;
+    std::cout << "Preparation Time: " << getPrepTime() << " minutes" << std::endl;
+    std::cout << std::fixed << std::setprecision(2) << "Price: $" << getPrice() << std::endl;
+    std::cout << "Cuisine Type: " << getCuisineType() << std::endl;
+}
+
+/**
+ * A plain dish has no attributes that depend on dietary requests, so it is left unchanged.
+ * @param request The requested accommodations.
+ */
+void PlainDish::dietaryAccommodations(const DietaryRequest&)
+{
+}
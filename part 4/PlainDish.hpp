@@ -0,0 +1,42 @@
+#ifndef PLAINDISH_HPP
+#define PLAINDISH_HPP
+
+#include "Dish.hpp"
+#include <string>
+
+/**
+ * @class PlainDish
+ * @brief A dish with only the fields of Dish. Snapshots and the write-ahead log restore any dish that is not an
+ * Appetizer, MainCourse or Dessert as a PlainDish, keeping its name, ingredients, preparation time, price and
+ * cuisine type.
+ */
+class PlainDish : public Dish {
+public:
+    /**
+     * Default constructor.
+     */
+    PlainDish();
+
+    /**
+     * Parameterized constructor.
+     * @param name The name of the dish.
+     * @param ingredients The ingredients used in the dish.
+     * @param prep_time The preparation time in minutes.
+     * @param price The price of the dish.
+     * @param cuisine_type The cuisine type of the dish.
+     */
+    PlainDish(const std::string& name, const std::vector<Ingredient>& ingredients, int prep_time, double price, CuisineType cuisine_type);
+
+    /**
+     * Displays the dish's name, ingredients, preparation time, price and cuisine type.
+     */
+    void display() const override;
+
+    /**
+     * A plain dish has no attributes that depend on dietary requests, so it is left unchanged.
+     * @param request The requested accommodations.
+     */
+    void dietaryAccommodations(const DietaryRequest& request) override;
+};
+
+#endif // PLAINDISH_HPP
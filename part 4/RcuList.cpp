@@ -0,0 +1,286 @@
+/** ADT list: Read-copy-update list implementation.
+
+ Implementation file for the class RcuList.
+ A reader announces the epoch it saw before it loads current_ptr_, and a writer reads the epoch after it
+ replaces current_ptr_, so a reader that can hold a retired version announced an epoch no later than the
+ one the version was retired in. A version retired in epoch e is freed once every active reader announced
+ an epoch above e.
+ @file RcuList.cpp */
+
+#include "RcuList.hpp"  // Header file
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <thread>
+
+// Leaves the read-side critical section
+template<class T>
+RcuList<T>::Snapshot::~Snapshot()
+{
+   if (slot_ptr_ != nullptr)
+      slot_ptr_->store(0, std::memory_order_release);
+}  // end destructor
+
+
+// constructor
+template<class T>
+RcuList<T>::RcuList() : current_ptr_(new Version()), epoch_(1)
+{
+}  // end default constructor
+
+
+// destructor
+template<class T>
+RcuList<T>::~RcuList()
+{
+   for (std::pair<uint64_t, Version*>& retired : retired_)
+      delete retired.second;
+   delete current_ptr_.load();
+}  // end destructor
+
+
+/**@return a snapshot of the current version, without blocking writers or other readers */
+template<class T>
+typename RcuList<T>::Snapshot RcuList<T>::read() const
+{
+   std::atomic<uint64_t>* slot_ptr = enterRead();
+   return Snapshot(current_ptr_.load(), slot_ptr);
+}  // end read
+
+
+/**@return true if the current version is empty */
+template<class T>
+bool RcuList<T>::isEmpty() const
+{
+   return read().isEmpty();
+}  // end isEmpty
+
+
+/**@return the number of items in the current version */
+template<class T>
+int RcuList<T>::getLength() const
+{
+   return read().getLength();
+}  // end getLength
+
+
+/**
+ @param position indicating the position of the data to be retrieved
+ @return data item found at position in the current version. If position is not a valid
+        position < getLength() throws  PrecondViolatedExcep */
+template<class T>
+T RcuList<T>::getEntry(int position) const
+{
+   Snapshot snapshot = read();
+
+   // Enforce precondition
+   bool ableToGet = (position >= 0) && (position < snapshot.getLength());
+   if (ableToGet)
+   {
+      return snapshot[position];
+   }
+   else
+   {
+      std::string message = "getEntry() called with an empty list or ";
+      message = message + "invalid position.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+}  // end getEntry
+
+
+/**
+ @param position indicating point of insertion
+ @param new_entry to be inserted in list
+ @post new_entry is added at position in a newly published version
+ @return true if valid position (0 <= position <= getLength()) */
+template<class T>
+bool RcuList<T>::insert(int position, const T& new_entry)
+{
+   return update([&](std::vector<T>& items)
+   {
+      bool able_to_insert = (position >= 0) && (position <= static_cast<int>(items.size()));
+      if (able_to_insert)
+         items.insert(items.begin() + position, new_entry);
+      return able_to_insert;
+   });
+}  // end insert
+
+
+template<class T>
+void RcuList<T>::push_back(const T& new_entry)
+{
+   update([&](std::vector<T>& items)
+   {
+      items.push_back(new_entry);
+      return true;
+   });
+}  // end push_back
+
+
+template<class T>
+void RcuList<T>::push_front(const T& new_entry)
+{
+   insert(0, new_entry);
+}  // end push_front
+
+
+/**
+ @param position indicating point of deletion
+ @post entry at position is deleted in a newly published version, if any. List order is retained.
+ @return true if there is an entry at position to be deleted, false otherwise */
+template<class T>
+bool RcuList<T>::remove(int position)
+{
+   return update([&](std::vector<T>& items)
+   {
+      bool able_to_remove = (position >= 0) && (position < static_cast<int>(items.size()));
+      if (able_to_remove)
+         items.erase(items.begin() + position);
+      return able_to_remove;
+   });
+}  // end remove
+
+
+/**
+ @param position of the entry to move
+ @post the entry at position is first and the entries before it move back one place, in one version
+ @return true if there is an entry at position, false otherwise */
+template<class T>
+bool RcuList<T>::moveToFront(int position)
+{
+   return update([&](std::vector<T>& items)
+   {
+      bool able_to_move = (position >= 0) && (position < static_cast<int>(items.size()));
+      if (able_to_move)
+         std::rotate(items.begin(), items.begin() + position, items.begin() + position + 1);
+      return able_to_move;
+   });
+}  // end moveToFront
+
+
+/**@post an empty version is published */
+template<class T>
+void RcuList<T>::clear()
+{
+   std::lock_guard<std::mutex> lock(writer_mutex_);
+   publish(new Version());
+}  // end clear
+
+
+/**
+ Applies a change of any size as one version.
+ @return the value modify returned */
+template<class T>
+template<class Modify>
+bool RcuList<T>::update(Modify modify)
+{
+   std::lock_guard<std::mutex> lock(writer_mutex_);
+
+   // Only writers replace current_ptr_, so the version cannot be retired while the mutex is held
+   Version* next_ptr = new Version(*current_ptr_.load());
+   bool changed = false;
+   try
+   {
+      changed = modify(next_ptr->items_);
+   }
+   catch (...)
+   {
+      delete next_ptr;
+      throw;
+   }  // end try
+
+   if (changed)
+      publish(next_ptr);
+   else
+      delete next_ptr;
+   return changed;
+}  // end update
+
+
+/**@post every snapshot taken before the call has been destroyed, and every retired version freed */
+template<class T>
+void RcuList<T>::synchronize()
+{
+   std::lock_guard<std::mutex> lock(writer_mutex_);
+
+   // Readers that start from here on announce a later epoch than every reader to wait for
+   uint64_t wait_epoch = epoch_.fetch_add(1);
+   while (oldestReader() <= wait_epoch)
+      std::this_thread::yield();
+   reclaim();
+}  // end synchronize
+
+
+/**@return replaced versions still waiting for their readers */
+template<class T>
+size_t RcuList<T>::getRetiredCount() const
+{
+   std::lock_guard<std::mutex> lock(writer_mutex_);
+   return retired_.size();
+}  // end getRetiredCount
+
+
+
+/************* PRIVATE METHODS ************/
+
+
+// Claims a free reader slot and announces the current epoch in it
+template<class T>
+std::atomic<uint64_t>* RcuList<T>::enterRead() const
+{
+   // Start at a slot picked by thread, so threads rarely contend for one
+   size_t index = std::hash<std::thread::id>()(std::this_thread::get_id()) % READER_SLOTS;
+   while (true)
+   {
+      uint64_t free_slot = 0;
+      if (slots_[index].epoch.compare_exchange_strong(free_slot, epoch_.load()))
+         return &slots_[index].epoch;
+      index = (index + 1) % READER_SLOTS;
+   }  // end while
+}  // end enterRead
+
+
+// Makes next the current version and retires the one it replaces. Call with writer_mutex_ held.
+template<class T>
+void RcuList<T>::publish(Version* next_ptr)
+{
+   Version* old_ptr = current_ptr_.exchange(next_ptr);
+   retired_.push_back({epoch_.fetch_add(1), old_ptr});
+   reclaim();
+}  // end publish
+
+
+// Frees the retired versions that no reader can still hold. Call with writer_mutex_ held.
+template<class T>
+void RcuList<T>::reclaim()
+{
+   uint64_t oldest = oldestReader();
+   size_t kept = 0;
+   for (std::pair<uint64_t, Version*>& retired : retired_)
+   {
+      if (retired.first < oldest)
+         delete retired.second;
+      else
+         retired_[kept++] = retired;
+   }  // end for
+   retired_.resize(kept);
+}  // end reclaim
+
+
+// @return the lowest epoch announced by a reader, or UINT64_MAX if no reader is active
+template<class T>
+uint64_t RcuList<T>::oldestReader() const
+{
+   uint64_t oldest = std::numeric_limits<uint64_t>::max();
+   for (const ReaderSlot& slot : slots_)
+   {
+      uint64_t epoch = slot.epoch.load();
+      if (epoch != 0 && epoch < oldest)
+         oldest = epoch;
+   }  // end for
+   return oldest;
+}  // end oldestReader
+
+
+//  End of implementation file.
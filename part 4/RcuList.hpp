@@ -0,0 +1,159 @@
+/** ADT list: Read-copy-update list for many reader threads and an occasional writer.
+    Readers take a Snapshot with read(), which neither locks nor writes shared data other than a reader slot,
+    and walk an immutable version of the list for as long as they hold it. Writers are serialized by a mutex;
+    each change copies the current version, edits the copy and publishes it with one atomic exchange, so a
+    reader sees either the whole change or none of it. A replaced version is retired and freed once every
+    reader that could still be walking it has dropped its snapshot (epoch-based reclamation).
+    Positions follow LinkedList: 0 to getLength() - 1, and getEntry throws PrecondViolatedExcep for an invalid
+    position. A write costs O(n) for the copy, which suits lists that are read far more often than changed.
+    @file RcuList.hpp */
+
+#ifndef RCU_LIST_
+#define RCU_LIST_
+
+#include "PrecondViolatedExcep.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+template<class T>
+class RcuList
+{
+   struct Version;
+
+public:
+   /** A reader's view of one version of the list; the version stays valid until the snapshot is destroyed.
+       A thread should not keep a snapshot while it waits on a writer, or synchronize() will wait for it */
+   class Snapshot
+   {
+   public:
+      using const_iterator = typename std::vector<T>::const_iterator;
+
+      Snapshot(Snapshot&& other) noexcept : version_ptr_(other.version_ptr_), slot_ptr_(other.slot_ptr_)
+      {
+         other.slot_ptr_ = nullptr;
+      }
+      Snapshot(const Snapshot&) = delete;
+      Snapshot& operator=(const Snapshot&) = delete;
+      Snapshot& operator=(Snapshot&&) = delete;
+      ~Snapshot();
+
+      /**@return the number of entries in this version */
+      int getLength() const { return static_cast<int>(version_ptr_->items_.size()); }
+      bool isEmpty() const { return version_ptr_->items_.empty(); }
+
+      /**@return the entry at position, 0 <= position < getLength() */
+      const T& operator[](int position) const { return version_ptr_->items_[position]; }
+
+      const_iterator begin() const { return version_ptr_->items_.cbegin(); }
+      const_iterator end() const { return version_ptr_->items_.cend(); }
+
+   private:
+      friend class RcuList<T>;
+      Snapshot(const Version* version_ptr, std::atomic<uint64_t>* slot_ptr) : version_ptr_(version_ptr), slot_ptr_(slot_ptr) {}
+
+      const Version* version_ptr_;
+      std::atomic<uint64_t>* slot_ptr_;  // Reader slot to clear on destruction; nullptr once moved from
+   }; // end Snapshot
+
+   RcuList(); // constructor
+   RcuList(const RcuList<T>&) = delete;
+   RcuList<T>& operator=(const RcuList<T>&) = delete;
+
+   /** @pre no reader holds a snapshot of this list */
+   virtual ~RcuList(); // destructor
+
+   /**@return a snapshot of the current version, without blocking writers or other readers */
+   Snapshot read() const;
+
+   /**@return true if the current version is empty */
+   bool isEmpty() const;
+
+   /**@return the number of items in the current version */
+   int getLength() const;
+
+    /**
+     @param position indicating the position of the data to be retrieved
+     @return data item found at position in the current version. If position is not a valid
+            position < getLength() throws  PrecondViolatedExcep */
+   T getEntry(int position) const;
+
+    /**
+     @param position indicating point of insertion
+     @param new_entry to be inserted in list
+     @post new_entry is added at position in a newly published version
+     @return true if valid position (0 <= position <= getLength()) */
+   bool insert(int position, const T& new_entry);
+
+   void push_back(const T& new_entry);
+   void push_front(const T& new_entry);
+
+    /**
+     @param position indicating point of deletion
+     @post entry at position is deleted in a newly published version, if any. List order is retained.
+           Readers holding an older snapshot still see the entry, so an entry that owns resources
+           may be released only after synchronize()
+     @return true if there is an entry at position to be deleted, false otherwise */
+   bool remove(int position);
+
+    /**
+     @param position of the entry to move
+     @post the entry at position is first and the entries before it move back one place, in one version
+     @return true if there is an entry at position, false otherwise */
+   bool moveToFront(int position);
+
+   /**@post an empty version is published */
+   void clear();
+
+    /**
+     Applies a change of any size as one version, for edits that must not be seen half done.
+     @param modify called as modify(std::vector<T>& items) with a copy of the current entries, under the
+            writer mutex; it returns true to publish the edited copy, false to discard it
+     @return the value modify returned */
+   template<class Modify>
+   bool update(Modify modify);
+
+   /**@post every snapshot taken before the call has been destroyed, and every retired version freed */
+   void synchronize();
+
+   /**@return replaced versions still waiting for their readers */
+   size_t getRetiredCount() const;
+
+private:
+   // One immutable version of the list
+   struct Version {
+      std::vector<T> items_;
+   };
+
+   // A reader's announced epoch, 0 while the slot is free; padded so readers do not share a cache line
+   struct alignas(64) ReaderSlot {
+      std::atomic<uint64_t> epoch{0};
+   };
+
+   static constexpr int READER_SLOTS = 64;  // Readers at once; more wait for a slot to be freed
+
+   // Claims a free reader slot and announces the current epoch in it
+   std::atomic<uint64_t>* enterRead() const;
+
+   // Makes next the current version and retires the one it replaces. Call with writer_mutex_ held.
+   void publish(Version* next_ptr);
+
+   // Frees the retired versions that no reader can still hold. Call with writer_mutex_ held.
+   void reclaim();
+
+   // @return the lowest epoch announced by a reader, or UINT64_MAX if no reader is active
+   uint64_t oldestReader() const;
+
+   std::atomic<Version*> current_ptr_;  // Version handed to new readers
+   std::atomic<uint64_t> epoch_;        // Advanced after every publish; readers announce the value they see
+   mutable ReaderSlot slots_[READER_SLOTS];
+   mutable std::mutex writer_mutex_;    // Serializes writers; readers never take it
+   std::vector<std::pair<uint64_t, Version*>> retired_;  // Replaced versions and the epoch they were retired in
+
+}; // end RcuList
+
+#include "RcuList.cpp"
+#endif
@@ -0,0 +1,176 @@
+// ReplenishmentPlanner.cpp contains the implementation of the ReplenishmentPlanner class, which allocates backup stock across stations for a whole dish queue.
+#include "ReplenishmentPlanner.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// Simulated state of one station while planning
+struct StationState {
+    KitchenStation* station;
+    std::unordered_map<std::string, int> stock;                     // ingredient name -> quantity
+    std::unordered_map<std::string, std::vector<Ingredient>> recipes; // dish name -> required ingredients
+};
+
+} // namespace
+
+// Parameterized Constructor
+ReplenishmentPlanner::ReplenishmentPlanner(Objective objective) : objective_(objective) {
+}
+
+// Computes an allocation of backup stock across stations for a whole queue
+ReplenishmentPlan ReplenishmentPlanner::plan(const std::vector<Dish*>& orders, const std::vector<KitchenStation*>& stations,
+                                             const IngredientWarehouse& backup) const {
+    ReplenishmentPlan result;
+    result.assignments.assign(orders.size(), nullptr);
+
+    // Snapshot the stations that carry a queued dish and index them per dish, in routing order
+    std::unordered_map<std::string, std::vector<size_t>> carriers;
+    for (Dish* order : orders) {
+        carriers.emplace(order->getName(), std::vector<size_t>());
+    }
+    std::vector<StationState> states(stations.size());
+    for (size_t s = 0; s < stations.size(); ++s) {
+        states[s].station = stations[s];
+        for (Dish* dish : stations[s]->getDishes()) {
+            auto queued = carriers.find(dish->getName());
+            if (queued != carriers.end()) {
+                states[s].recipes[dish->getName()] = dish->getIngredients();
+                queued->second.push_back(s);
+            }
+        }
+        if (!states[s].recipes.empty()) {
+            for (const Ingredient& ingredient : stations[s]->getIngredientsStock()) {
+                states[s].stock[ingredient.name] += ingredient.quantity;
+            }
+        }
+    }
+
+    // Backup stock still unallocated, loaded from the warehouse on first use
+    std::unordered_map<std::string, int> spare;
+    auto spareOf = [&spare, &backup](const std::string& name) -> int& {
+        auto found = spare.find(name);
+        if (found == spare.end()) {
+            found = spare.emplace(name, backup.getQuantity(name)).first;
+        }
+        return found->second;
+    };
+
+    // Backup units needed to serve one more of a recipe at a station, or -1 if backup cannot cover it
+    auto costAt = [&spareOf](StationState& state, const std::vector<Ingredient>& recipe) -> int {
+        int units = 0;
+        for (const Ingredient& ingredient : recipe) {
+            if (ingredient.required_quantity <= 0) {
+                continue;
+            }
+            auto in_stock = state.stock.find(ingredient.name);
+            int lack = ingredient.required_quantity - (in_stock == state.stock.end() ? 0 : in_stock->second);
+            if (lack > 0) {
+                if (spareOf(ingredient.name) < lack) {
+                    return -1;
+                }
+                units += lack;
+            }
+        }
+        return units;
+    };
+
+    // Transfers are merged per station and ingredient
+    std::unordered_map<std::string, size_t> transfer_index;
+    auto commit = [&](size_t order, size_t s) {
+        StationState& state = states[s];
+        for (const Ingredient& ingredient : state.recipes[orders[order]->getName()]) {
+            if (ingredient.required_quantity <= 0) {
+                continue;
+            }
+            int& in_stock = state.stock[ingredient.name];
+            int lack = ingredient.required_quantity - in_stock;
+            if (lack > 0) {
+                spareOf(ingredient.name) -= lack;
+                in_stock += lack;
+                std::string key = std::to_string(s) + '\n' + ingredient.name;
+                auto found = transfer_index.find(key);
+                if (found == transfer_index.end()) {
+                    transfer_index.emplace(key, result.transfers.size());
+                    result.transfers.push_back({state.station, ingredient.name, lack});
+                } else {
+                    result.transfers[found->second].quantity += lack;
+                }
+            }
+            in_stock -= ingredient.required_quantity;
+        }
+        result.assignments[order] = state.station;
+        result.planned_dishes++;
+        result.planned_value += orders[order]->getPrice();
+    };
+
+    // Cheapest station for an order: (backup units, station index), or (-1, 0) if none can serve it
+    auto cheapest = [&](size_t order) -> std::pair<int, size_t> {
+        std::pair<int, size_t> best(-1, 0);
+        auto found = carriers.find(orders[order]->getName());
+        if (found == carriers.end()) {
+            return best;
+        }
+        for (size_t s : found->second) {
+            int units = costAt(states[s], states[s].recipes[orders[order]->getName()]);
+            if (units >= 0 && (best.first < 0 || units < best.first)) {
+                best = {units, s};
+            }
+        }
+        return best;
+    };
+
+    // Phase 1: in queue order, everything station stock serves without touching backup
+    std::vector<size_t> pending;
+    for (size_t order = 0; order < orders.size(); ++order) {
+        bool served = false;
+        auto found = carriers.find(orders[order]->getName());
+        if (found != carriers.end()) {
+            for (size_t s : found->second) {
+                if (costAt(states[s], states[s].recipes[orders[order]->getName()]) == 0) {
+                    commit(order, s);
+                    served = true;
+                    break;
+                }
+            }
+        }
+        if (!served) {
+            pending.push_back(order);
+        }
+    }
+
+    // Phase 2: spend backup stock on the remaining orders, cheapest (or most valuable per unit) first
+    auto keyOf = [this, &orders](size_t order, int units) -> double {
+        if (objective_ == MAXIMIZE_VALUE) {
+            return -orders[order]->getPrice() / std::max(units, 1);
+        }
+        return units;
+    };
+    typedef std::pair<double, size_t> Entry; // (key, order); ties go to the earlier order
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    for (size_t order : pending) {
+        std::pair<int, size_t> best = cheapest(order);
+        if (best.first >= 0) {
+            heap.push({keyOf(order, best.first), order});
+        }
+    }
+    while (!heap.empty()) {
+        Entry top = heap.top();
+        heap.pop();
+        std::pair<int, size_t> best = cheapest(top.second);
+        if (best.first < 0) {
+            continue; // Stock only shrinks, so this order can no longer be served
+        }
+        double key = keyOf(top.second, best.first);
+        if (key > top.first) {
+            heap.push({key, top.second}); // Earlier commitments made it dearer; look again later
+            continue;
+        }
+        commit(top.second, best.second);
+    }
+
+    return result;
+}
@@ -0,0 +1,64 @@
+/** Header file for the ReplenishmentPlanner class, which decides ahead of time how the backup ingredient stock
+    is split across stations so that as many queued dishes (or as much order value) as possible can be completed. **/
+
+#ifndef REPLENISHMENTPLANNER_HPP
+#define REPLENISHMENTPLANNER_HPP
+
+#include "KitchenStation.hpp"
+#include "IngredientWarehouse.hpp"
+#include "Dish.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * A move of backup stock to a station.
+ */
+struct StockTransfer {
+    KitchenStation* station;
+    std::string ingredient_name;
+    int quantity;
+};
+
+/**
+ * The outcome of planning: which station prepares each order, and which backup moves make that possible.
+ */
+struct ReplenishmentPlan {
+    std::vector<KitchenStation*> assignments; ///< One entry per order, in queue order; nullptr if the order cannot be completed.
+    std::vector<StockTransfer> transfers;     ///< Backup stock to move before preparing, at most one per station and ingredient.
+    int planned_dishes = 0;                   ///< Number of orders with a station.
+    double planned_value = 0.0;               ///< Sum of the prices of those orders.
+};
+
+class ReplenishmentPlanner {
+
+public:
+    /**
+     * What the planner maximizes when backup stock cannot cover every order.
+     */
+    enum Objective { MAXIMIZE_DISHES, MAXIMIZE_VALUE };
+
+    /**
+     * Parameterized Constructor
+     * @param objective What to maximize (default MAXIMIZE_DISHES).
+     */
+    ReplenishmentPlanner(Objective objective = MAXIMIZE_DISHES);
+
+    /**
+     * Computes an allocation of backup stock across stations for a whole queue.
+     * @param orders The queued dishes, in queue order.
+     * @param stations The kitchen stations, in routing order.
+     * @param backup The backup stock.
+     * @return: The plan. Nothing is modified; executing the plan is up to the caller.
+     * @post: Orders that station stock alone can serve are assigned first, in queue order, to the first station that can
+     * serve them. The remaining orders are then assigned greedily by the cost of their cheapest station (backup units
+     * needed) or by price per backup unit, re-evaluating an order's cost lazily whenever earlier commitments raised it.
+     * Costs never decrease as stock is committed, so an order popped with an up-to-date cost is the best remaining one.
+     */
+    ReplenishmentPlan plan(const std::vector<Dish*>& orders, const std::vector<KitchenStation*>& stations,
+                           const IngredientWarehouse& backup) const;
+
+private:
+    Objective objective_;
+};
+
+#endif // REPLENISHMENTPLANNER_HPP
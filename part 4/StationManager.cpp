@@ -1,83 +1,72 @@
 // StationManager.cpp contains the implementation file for the StationManager class, which manages kitchen stations,dish preparation, and ingredient replenishment.
 #include "StationManager.hpp"
+#include "StationSnapshot.hpp"
 #include <iostream>
+#include <unordered_map>
 
 // Default Constructor
-StationManager::StationManager() {
+StationManager::StationManager()
+    : batch_cooking_(false), replenishment_planning_(false), plan_objective_(ReplenishmentPlanner::MAXIMIZE_DISHES),
+      station_ordering_(FIXED), hit_decay_(0.99), hit_weight_(1.0), station_routing_(FIRST_FIT),
+      event_sink_(std::make_shared<TextEventSink>()), routing_probes_(0), routings_(0), order_parking_(false),
+      parked_orders_(std::make_shared<ParkedOrders>()) {
     // Initializes an empty station manager
 }
 
 
 // Adds a new station to the station manager
 bool StationManager::addStation(KitchenStation* station) {
-    return insert(item_count_, station);
+    push_back(station);
+    watchStation(station);
+    VB_METRICS(station_metrics_[station] = metrics_.stationCounters(station->getName()));
+    return true;
 }
 
 // Removes a station from the station manager by name
 bool StationManager::removeStation(const std::string& station_name) {
-    for (int i = 0; i < item_count_; ++i) {
-        if (getEntry(i)->getName() == station_name) {
-            return remove(i);
+    int position = 0;
+    for (KitchenStation* station : *this) {
+        if (station->getName() == station_name) {
+            station_hits_.erase(station);
+            station_busy_time_.erase(station);
+            station_metrics_.erase(station);
+            station->setStockListener(nullptr);
+            return remove(position);
         }
+        position++;
     }
     return false;
 }
 
 // Finds a station in the station manager by name
 KitchenStation* StationManager::findStation(const std::string& station_name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == station_name) {
-            return searchptr->getItem();
+    for (KitchenStation* station : *this) {
+        if (station->getName() == station_name) {
+            return station;
         }
-        searchptr = searchptr->getNext();
     }
     return nullptr;
 }
 
 // Moves a specified station to the front of the station manager list
 bool StationManager::moveStationToFront(const std::string& station_name) {
-    // First, make sure the station exists
-    if (findStation(station_name) == nullptr) {
-        return false;
-    }
-    
-    // If it's already at the front, return true
-    if (getHeadNode()->getItem()->getName() == station_name) {
-        return true;
+    for (iterator station = begin(); station != end(); ++station) {
+        if ((*station)->getName() == station_name) {
+            // Relink the station's node at the front in one step
+            moveToFront(station.getNode());
+            return true;
+        }
     }
-
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == station_name) {
-            // Make a copy of the station
-            KitchenStation* station = searchptr->getItem();
-            
-            // Remove the station from its current position
-            int pos = getStationIndex(searchptr->getItem()->getName());
-            remove(pos);
-            
-            // Insert the station at the front
-            insert(0, station);
-            
-            return true;  // Exit after moving the station
-        }
-        
-        searchptr = searchptr->getNext();  // Move to the next node
-    }
-    
     return false;
 }
 
 
 int StationManager::getStationIndex(const std::string& name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
     int index = 0;
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == name) {
+    for (KitchenStation* station : *this) {
+        if (station->getName() == name) {
             return index;
         }
-        searchptr = searchptr->getNext();
         index++;
     }
     return -1;
@@ -87,17 +76,24 @@ int StationManager::getStationIndex(const std::string& name) const {
 bool StationManager::mergeStations(const std::string& station_name1, const std::string& station_name2) {
     KitchenStation* station1 = findStation(station_name1);
     KitchenStation* station2 = findStation(station_name2);
-    if (station1 && station2) {
-        // take all the dishes from station2 and add them to station1
-        for (Dish* dish : station2->getDishes()) {
-            station1->assignDishToStation(dish);
+    if (station1 && station2 && station1 != station2) {
+        // move station2's dishes and stock into station1; station1 now owns the dishes
+        station1->absorbStation(*station2);
+        // station1 takes over station2's simulated work
+        auto busy = station_busy_time_.find(station2);
+        if (busy != station_busy_time_.end()) {
+            station_busy_time_[station1] += busy->second;
         }
-        // take all the ingredients from station2 and add them to station1
-        for (Ingredient ingredient : station2->getIngredientsStock()) {
-            station1->replenishStationIngredients(ingredient);
-        }
-        // remove station2 from the list
+        // remove station2 from the list and free it, now that it owns nothing
         removeStation(station_name2);
+        delete station2;
+        if (wal_) {
+            // later records may use the stock station1 took over
+            WalRecord record(WalRecord::STATION_MERGE);
+            record.station = station_name1;
+            record.merged_station = station_name2;
+            wal_->append(record);
+        }
         return true;
     }
     return false;
@@ -106,8 +102,9 @@ bool StationManager::mergeStations(const std::string& station_name1, const std::
 // Assigns a dish to a specific station
 bool StationManager::assignDishToStation(const std::string& station_name, Dish* dish) {
     KitchenStation* station = findStation(station_name);
-    if (station) {
-        return station->assignDishToStation(dish);
+    if (station && station->assignDishToStation(dish)) {
+        parked_orders_->clear(); // A new carrier may serve any parked order
+        return true;
     }
     return false;
 }
@@ -117,6 +114,12 @@ bool StationManager::replenishIngredientAtStation(const std::string& station_nam
     KitchenStation* station = findStation(station_name);
     if (station) {
         station->replenishStationIngredients(ingredient);
+        if (wal_) {
+            WalRecord record(WalRecord::STOCK_ADD);
+            record.station = station_name;
+            record.ingredient = ingredient;
+            wal_->append(record);
+        }
         return true;
     }
     return false;
@@ -124,12 +127,10 @@ bool StationManager::replenishIngredientAtStation(const std::string& station_nam
 
 // Checks if any station in the station manager can complete an order for a specific dish
 bool StationManager::canCompleteOrder(const std::string& dish_name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->canCompleteOrder(dish_name)) {
+    for (KitchenStation* station : *this) {
+        if (station->canCompleteOrder(dish_name)) {
             return true;
         }
-        searchptr = searchptr->getNext();
     }
     return false;
 }
@@ -137,8 +138,9 @@ bool StationManager::canCompleteOrder(const std::string& dish_name) const {
 // Prepares a dish at a specific station if possible
 bool StationManager::prepareDishAtStation(const std::string& station_name, const std::string& dish_name) {
     KitchenStation* station = findStation(station_name);
-    if (station && station->canCompleteOrder(dish_name)) {
-        return station->prepareDish(dish_name);
+    if (station && station->canCompleteOrder(dish_name) && station->prepareDish(dish_name)) {
+        logPrepare(station, dish_name, 0);
+        return true;
     }
     return false;
 }
@@ -158,7 +160,7 @@ std::queue<Dish*> StationManager::getDishQueue() const {
  * @post: The backup ingredients remain unchanged.
  */
 std::vector<Ingredient> StationManager::getBackupIngredients() const {
-    return backup_ingredients_;
+    return backup_ingredients_.getIngredients();
 }
 
 /**
@@ -173,6 +175,14 @@ void StationManager::setDishQueue(const std::queue<Dish*>& dish_queue) {
 
     // Copy the provided queue to the member variable
     dish_queue_ = dish_queue;
+    metrics_.observeQueueDepth(dish_queue_.size());
+    if (wal_) {
+        std::queue<Dish*> queue = dish_queue_;
+        while (!queue.empty()) {
+            logEnqueue(*queue.front());
+            queue.pop();
+        }
+    }
 }
 
 /**
@@ -185,7 +195,11 @@ void StationManager::addDishToQueue(Dish* dish) {
     if (!dish) {
         throw std::invalid_argument("Dish pointer must not be null.");
     }
+    OrderTracer::Scope trace("addDishToQueue", dish, dish);
+    OrderTracer::beginOrder(dish);
     dish_queue_.push(dish);
+    metrics_.observeQueueDepth(dish_queue_.size());
+    logEnqueue(*dish);
 }
 
 /**
@@ -200,11 +214,19 @@ void StationManager::addDishToQueue(Dish* dish, const Dish::DietaryRequest& requ
         throw std::invalid_argument("Dish pointer must not be null.");
     }
 
+    OrderTracer::Scope trace("addDishToQueue", dish, dish);
+    OrderTracer::beginOrder(dish);
+
     // Adjust the dish for dietary accommodations
-    dish->dietaryAccommodations(request);
+    {
+        OrderTracer::Scope accommodation("accommodation", dish, dish);
+        dish->dietaryAccommodations(request);
+    }
 
     // Add the dish to the queue after adjustments
     dish_queue_.push(dish);
+    metrics_.observeQueueDepth(dish_queue_.size());
+    logEnqueue(*dish);
 }
 
 /**
@@ -220,19 +242,65 @@ bool StationManager::prepareNextDish() {
     }
 
     Dish* dish = dish_queue_.front(); // Get the first dish in the queue
-    Node<KitchenStation*>* stationNode = getHeadNode(); // Start from the first station
+    if (isParked(dish)) {
+        return false; // Nothing it lacks has arrived since it failed
+    }
+    OrderTracer::Scope trace("routing", dish, dish);
+    int position = 0;
+    routings_++;
+    VB_METRICS(uint64_t routing_start = MetricsRegistry::now());
+
+    // Try the station preferred by the routing policy first
+    KitchenStation* preferred = chooseStation(dish->getName());
+    if (preferred != nullptr) {
+        routing_probes_++;
+        VB_METRICS(uint64_t attempt_start = MetricsRegistry::now());
+        bool prepared = preferred->prepareDish(dish->getName(), dish);
+        VB_METRICS(metrics_.recordStationAttempt(stationMetrics(preferred), prepared, MetricsRegistry::now() - attempt_start));
+        if (prepared) {
+            VB_METRICS(metrics_.recordDish(metrics_.dishCounters(dish->getName()), 1, true, MetricsRegistry::now() - routing_start));
+            OrderTracer::completeOrder(dish);
+            logPrepare(preferred, dish->getName(), 0);
+            logQueueRemove({0}, dish_queue_.size() - 1);
+            dish_queue_.pop();
+            addBusyTime(preferred, dish->getName(), 1);
+            recordStationHit(preferred, -1);
+            return true;
+        }
+    }
 
     // Iterate through the stations
-    while (stationNode != nullptr) {
-        KitchenStation* station = stationNode->getItem();
-        if (station->prepareDish(dish->getName())) {
+    for (KitchenStation* station : *this) {
+        if (station == preferred) {
+            position++;
+            continue;
+        }
+        routing_probes_++;
+        VB_METRICS(uint64_t attempt_start = MetricsRegistry::now());
+        if (station->prepareDish(dish->getName(), dish)) {
+            VB_METRICS(uint64_t finished = MetricsRegistry::now());
+            VB_METRICS(metrics_.recordStationAttempt(stationMetrics(station), true, finished - attempt_start));
+            VB_METRICS(metrics_.recordDish(metrics_.dishCounters(dish->getName()), 1, true, finished - routing_start));
+            OrderTracer::completeOrder(dish);
+            logPrepare(station, dish->getName(), 0);
+            logQueueRemove({0}, dish_queue_.size() - 1);
             dish_queue_.pop(); // Remove the prepared dish from the queue
+            addBusyTime(station, dish->getName(), 1);
+            recordStationHit(station, position);
             return true;       // Successfully prepared the dish
         }
-        stationNode = stationNode->getNext(); // Move to the next station
+#ifndef VB_DISABLE_METRICS
+        // Only a station that carries the dish counts a failed attempt
+        if (station->getDish(dish->getName()) != nullptr) {
+            metrics_.recordStationAttempt(stationMetrics(station), false, 0);
+        }
+#endif
+        position++;
     }
 
     // No station could prepare the dish
+    VB_METRICS(metrics_.recordDish(metrics_.dishCounters(dish->getName()), 1, false, 0));
+    parkOrder(dish);
     return false;
 }
 
@@ -257,12 +325,16 @@ void StationManager::displayDishQueue() const {
  * @post: The dish queue is emptied, and all allocated memory is freed.
  */
 void StationManager::clearDishQueue() {
+    parked_orders_->clear();
     // Free memory for each dish and remove it from the queue
     while (!dish_queue_.empty()) {
         Dish* dish = dish_queue_.front();
         delete dish;          // Free dynamically allocated memory
         dish_queue_.pop();    // Remove the dish from the queue
     }
+    if (wal_) {
+        wal_->append(WalRecord(WalRecord::QUEUE_CLEAR));
+    }
 }
 
 /**
@@ -274,50 +346,51 @@ void StationManager::clearDishQueue() {
  * @post: Updates the ingredient stock at the station and adjusts the backup stock.
  */
 bool StationManager::replenishStationIngredientFromBackup(const std::string& station_name, const std::string& ingredient_name, int quantity) {
+    if (quantity <= 0) {
+        return false; // Nothing to move
+    }
     KitchenStation* station = findStation(station_name); // Find the station by name
     if (!station) {
         return false; // Station not found
     }
 
-    // Search for the ingredient in the backup stock
-    for (size_t i = 0; i < backup_ingredients_.size(); ++i) {
-        Ingredient& ingredient = backup_ingredients_[i];
-
-        // Check if the ingredient matches and has sufficient quantity
-        if (ingredient.name == ingredient_name && ingredient.quantity >= quantity) {
-            // Replenish the station with the ingredient
-            station->replenishStationIngredients(Ingredient(ingredient.name, quantity, 0, ingredient.price));
-
-            // Deduct the used quantity from the backup stock
-            ingredient.quantity -= quantity;
-
-            // Remove the ingredient from backup if it's fully used up
-            if (ingredient.quantity == 0) {
-                backup_ingredients_.erase(backup_ingredients_.begin() + i);
-            }
-
-            return true; // Replenishment successful
-        }
+    // Deduct the quantity from the backup stock first, so the station only gets stock the backup gave up
+    const Ingredient* ingredient = backup_ingredients_.find(ingredient_name);
+    double price = ingredient ? ingredient->price : 0.0;
+    if (!ingredient || !backup_ingredients_.take(ingredient_name, quantity)) {
+        VB_METRICS(metrics_.recordBackupMiss(stationMetrics(station), nullptr));
+        return false; // Ingredient not found or insufficient quantity in backup
     }
 
-    // Ingredient not found or insufficient quantity in backup
-    return false;
+    // Replenish the station
+    VB_METRICS(metrics_.recordReplenishment(stationMetrics(station), nullptr));
+    logTransfer(station, ingredient_name, quantity, price);
+    station->replenishStationIngredients(Ingredient(ingredient_name, quantity, 0, price));
+    return true;
 }
 
 /**
  * Adds a batch of ingredients to the backup stock.
  * @param ingredients A vector of Ingredient objects to add to the backup stock.
  * @return: True if all ingredients were added successfully; false otherwise.
- * @post: The backup stock is updated with the provided ingredients.
+ * @post: Each ingredient is merged into the backup stock.
  */
 bool StationManager::addBackupIngredients(const std::vector<Ingredient>& ingredients) {
     if (ingredients.empty()) {
         return false; // Nothing to add
     }
-
-    // Replace the current backup ingredients with the new batch
-    backup_ingredients_ = ingredients;
-    return true;
+    if (wal_) {
+        for (const Ingredient& ingredient : ingredients) {
+            WalRecord record(WalRecord::BACKUP_ADD);
+            record.ingredient = ingredient;
+            wal_->append(record);
+        }
+    }
+    bool added = backup_ingredients_.addAll(ingredients);
+    for (const Ingredient& ingredient : ingredients) {
+        parked_orders_->wake(ingredient.name);
+    }
+    return added;
 }
 
 /**
@@ -327,27 +400,43 @@ bool StationManager::addBackupIngredients(const std::vector<Ingredient>& ingredi
  * @post: If the ingredient already exists, its quantity is increased; otherwise, it is added.
  */
 bool StationManager::addBackupIngredient(const Ingredient& ingredient) {
-    // Check if the ingredient already exists in the backup stock
-    for (Ingredient& backup_ingredient : backup_ingredients_) {
-        if (backup_ingredient.name == ingredient.name) {
-            // Increase the quantity of the existing ingredient
-            backup_ingredient.quantity += ingredient.quantity;
-            return true;
-        }
+    if (wal_) {
+        WalRecord record(WalRecord::BACKUP_ADD);
+        record.ingredient = ingredient;
+        wal_->append(record);
     }
-
-    // Add the new ingredient to the backup stock
-    backup_ingredients_.push_back(ingredient);
-    return true;
+    bool added = backup_ingredients_.add(ingredient);
+    if (added) {
+        parked_orders_->wake(ingredient.name);
+    }
+    return added;
 }
 
 
 /**
  * Clears all ingredients from the backup stock.
- * @post: The backup_ingredients_ vector is emptied.
+ * @post: The backup_ingredients_ warehouse is emptied.
  */
 void StationManager::clearBackupIngredients() {
     backup_ingredients_.clear();
+    if (wal_) {
+        wal_->append(WalRecord(WalRecord::BACKUP_CLEAR));
+    }
+}
+
+/**
+ * @param ingredient_name The name of an ingredient.
+ * @return: The quantity of the ingredient in the backup stock (0 if none).
+ */
+int StationManager::getBackupQuantity(const std::string& ingredient_name) const {
+    return backup_ingredients_.getQuantity(ingredient_name);
+}
+
+/**
+ * @return: The total value (quantity times price) of the backup stock.
+ */
+double StationManager::getBackupStockValue() const {
+    return backup_ingredients_.getTotalValue();
 }
 
 /**
@@ -368,20 +457,47 @@ in the same order
  *        Logs the preparation status, replenishment details, and unavailability of dishes.
  */
 void StationManager::processAllDishes() {
+    if (replenishment_planning_) {
+        processPlannedDishes();
+        return;
+    }
+    if (batch_cooking_) {
+        processCoalescedDishes();
+        return;
+    }
+
     std::queue<Dish *> unPreparedDishes; // Queue to hold unprepared dishes
+    std::vector<uint32_t> preparedPositions; // Queue positions of the prepared dishes, for the write-ahead log
+    uint32_t position = 0;
 
     // Process each dish in the preparation queue
     while (!dish_queue_.empty()) {
         Dish* dish = dish_queue_.front(); // Get the dish at the front of the queue
+        if (isParked(dish)) {
+            // Skip it without probing: nothing it lacks has arrived since it failed
+            unPreparedDishes.push(dish);
+            dish_queue_.pop();
+            position++;
+            continue;
+        }
+        OrderTracer::Scope trace("routing", dish, dish);
         bool isPrepared = false;         // Tracks whether the dish has been successfully prepared
         bool isFound = false;            // Tracks whether the dish is found in the current station
 
-        std::cout << "PREPARING DISH: " << dish->getName() << std::endl;
+        logEvent(KitchenEvent::DISH_STARTED, "", dish->getName());
+        routings_++;
+        VB_METRICS(uint64_t routing_start = MetricsRegistry::now());
 
-        // Iterate through all kitchen stations
-        for (int i = 0; i < item_count_; ++i) {
-            KitchenStation* kitchenStation = getEntry(i); // Get the current station
-            std::cout << kitchenStation->getName() << ": attempting to prepare " << dish->getName() << "..." << std::endl;
+        // Iterate through all kitchen stations, starting with the one preferred by the routing policy
+        KitchenStation* preferred = chooseStation(dish->getName());
+        const_iterator next_station = begin();
+        for (int i = (preferred != nullptr ? -1 : 0); i < item_count_; ++i) {
+            KitchenStation* kitchenStation = i < 0 ? preferred : *next_station++; // Get the current station
+            if (i >= 0 && kitchenStation == preferred) {
+                continue;
+            }
+            routing_probes_++;
+            logEvent(KitchenEvent::STATION_ATTEMPT, kitchenStation->getName(), dish->getName());
 
             isFound = false; // Reset dish found flag for the current station
 
@@ -389,60 +505,35 @@ void StationManager::processAllDishes() {
             for (Dish* station_dish : kitchenStation->getDishes()) {
                 if (station_dish->getName() == dish->getName()) {
                     isFound = true; // Dish is found in this station
+                    VB_METRICS(uint64_t attempt_start = MetricsRegistry::now());
 
                     // Check if the station can complete the order
                     if (kitchenStation->canCompleteOrder(dish->getName())) {
                         // Attempt to prepare the dish
-                        if (kitchenStation->prepareDish(dish->getName())) {
+                        if (kitchenStation->prepareDish(dish->getName(), dish)) {
                             isPrepared = true;
-                            std::cout << kitchenStation->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
+                            logPrepare(kitchenStation, dish->getName(), 0);
+                            logEvent(KitchenEvent::DISH_PREPARED, kitchenStation->getName(), dish->getName());
                         }
+                        VB_METRICS(metrics_.recordStationAttempt(stationMetrics(kitchenStation), isPrepared, MetricsRegistry::now() - attempt_start));
                     } else {
                         // Handle replenishment if ingredients are insufficient
-                        std::cout << kitchenStation->getName() << ": Insufficient ingredients. Replenishing ingredients..." << std::endl;
-
-                        // Replenish all required ingredients
-                        for (const Ingredient& requiredIngredient : station_dish->getIngredients()) {
-                            bool isIngredientFound = false; // Tracks if the ingredient is in stock
-
-                            // Check the station's ingredient stock
-                            for (const Ingredient& stockIngredient : kitchenStation->getIngredientsStock()) {
-                                if (requiredIngredient.name == stockIngredient.name) {
-                                    isIngredientFound = true;
-
-                                    // Calculate the shortage
-                                    int requiredQuantity = requiredIngredient.required_quantity - stockIngredient.quantity;
-
-                                    // Replenish if there is a shortage
-                                    if (requiredQuantity > 0) {
-                                        if (!replenishStationIngredientFromBackup(kitchenStation->getName(), requiredIngredient.name, requiredQuantity)) {
-                                            std::cout << kitchenStation->getName() 
-                                                      << ": Unable to replenish ingredients. Failed to prepare " 
-                                                      << dish->getName() << "." << std::endl;
-                                            break;
-                                        }
-                                    }
-                                    break; // Stop searching once the ingredient is found
-                                }
-                            }
-
-                            // If the ingredient was not found in stock, attempt replenishment
-                            if (!isIngredientFound) {
-                                if (!replenishStationIngredientFromBackup(kitchenStation->getName(), requiredIngredient.name, requiredIngredient.required_quantity)) {
-                                    std::cout << kitchenStation->getName() 
-                                              << ": Unable to replenish ingredients. Failed to prepare " 
-                                              << dish->getName() << "." << std::endl;
-                                    break; // Stop replenishment attempts if one ingredient fails
-                                }
-                            }
+                        logEvent(KitchenEvent::INGREDIENTS_SHORT, kitchenStation->getName(), dish->getName());
+
+                        // Move the whole shortfall from backup in one transaction, or nothing at all
+                        if (!replenishShortfall(kitchenStation, station_dish, 1)) {
+                            logEvent(KitchenEvent::REPLENISH_FAILED, kitchenStation->getName(), dish->getName());
                         }
 
                         // Retry preparing the dish after replenishment
-                        if (kitchenStation->prepareDish(dish->getName())) {
-                            std::cout << kitchenStation->getName() << ": Ingredients replenished." << std::endl;
-                            std::cout << kitchenStation->getName() << ": Successfully prepared " 
-                                      << dish->getName() << "." << std::endl;
+                        if (kitchenStation->prepareDish(dish->getName(), dish)) {
+                            logPrepare(kitchenStation, dish->getName(), 0);
+                            logEvent(KitchenEvent::INGREDIENTS_REPLENISHED, kitchenStation->getName(), dish->getName());
+                            logEvent(KitchenEvent::DISH_PREPARED, kitchenStation->getName(), dish->getName());
                             isPrepared = true;
+                        }
+                        VB_METRICS(metrics_.recordStationAttempt(stationMetrics(kitchenStation), isPrepared, MetricsRegistry::now() - attempt_start));
+                        if (isPrepared) {
                             break; // Stop iterating through stations
                         }
                     }
@@ -451,30 +542,1037 @@ void StationManager::processAllDishes() {
 
             // Log if the dish is not available at the current station
             if (!isFound) {
-                std::cout << kitchenStation->getName() << ": Dish not available. Moving to next station..." << std::endl;
+                logEvent(KitchenEvent::DISH_NOT_AVAILABLE, kitchenStation->getName(), dish->getName());
             }
 
             // Stop searching if the dish has been prepared
             if (isPrepared) {
+                addBusyTime(kitchenStation, dish->getName(), 1);
+                recordStationHit(kitchenStation, i);
                 break;
             }
         }
 
+        VB_METRICS(metrics_.recordDish(metrics_.dishCounters(dish->getName()), 1, isPrepared, MetricsRegistry::now() - routing_start));
+        if (isPrepared) {
+            OrderTracer::completeOrder(dish);
+            preparedPositions.push_back(position);
+        }
+        position++;
+
         // If the dish could not be prepared, add it to the unprepared dishes queue
         if (!isPrepared) {
-            std::cout << dish->getName() << " was not prepared." << std::endl;
+            logEvent(KitchenEvent::DISH_NOT_PREPARED, "", dish->getName());
             unPreparedDishes.push(dish);
+            parkOrder(dish);
         }
 
         dish_queue_.pop(); // Remove the dish from the original queue
-        std::cout << std::endl; // Add a blank line for readability
+        logEvent(KitchenEvent::SEPARATOR, "", ""); // Add a blank line for readability
     }
 
-    // Restore unprepared dishes to the main queue
-    setDishQueue(unPreparedDishes);
+    // Restore unprepared dishes to the main queue; the queue is empty, so there is nothing to free or log again
+    dish_queue_.swap(unPreparedDishes);
+    metrics_.observeQueueDepth(dish_queue_.size());
+    logQueueRemove(std::move(preparedPositions), dish_queue_.size());
 
     // Final message
-    std::cout << std::endl << std::endl << "All dishes have been processed." << std::endl;
+    logEvent(KitchenEvent::QUEUE_PROCESSED, "", "");
+    event_sink_->flush();
+}
+
+
+
+
+/**
+ * Enables or disables batch cooking in processAllDishes.
+ * @param enabled True to coalesce identical queued dishes before preparing them.
+ */
+void StationManager::setBatchCooking(bool enabled) {
+    batch_cooking_ = enabled;
 }
 
+/**
+ * @return: True if processAllDishes coalesces identical dishes; false otherwise.
+ */
+bool StationManager::isBatchCooking() const {
+    return batch_cooking_;
+}
 
+/**
+ * Replenishes a station from the backup stock with everything it lacks to prepare a dish.
+ * @param station_name The name of the station.
+ * @param dish_name The name of a dish the station carries.
+ * @return: True if the station can prepare the dish afterwards; false if the station or dish was not found
+ *          or the backup stock could not cover the whole shortfall.
+ * @post: Either the whole shortfall is moved from backup to the station, or nothing is moved.
+ */
+bool StationManager::replenishForDish(const std::string& station_name, const std::string& dish_name) {
+    KitchenStation* station = findStation(station_name);
+    if (!station) {
+        return false;
+    }
+    Dish* station_dish = station->getDish(dish_name);
+    if (!station_dish) {
+        return false;
+    }
+    return replenishShortfall(station, station_dish, 1);
+}
+
+/**
+ * Moves from backup everything a station lacks to cover a number of servings of a dish, or nothing at all.
+ * @return: True if the station's stock covers the servings afterwards; false otherwise.
+ */
+bool StationManager::replenishShortfall(KitchenStation* station, Dish* station_dish, int servings) {
+    std::vector<Ingredient> required = station_dish->getIngredients();
+    std::vector<Ingredient> stock = station->getIngredientsStock();
+
+    // Shortfall vector: what the station lacks of each required ingredient
+    std::vector<int> shortfall(required.size(), 0);
+    bool short_anything = false;
+    for (size_t i = 0; i < required.size(); ++i) {
+        int in_stock = 0;
+        for (const Ingredient& stock_ingredient : stock) {
+            if (stock_ingredient.name == required[i].name) {
+                in_stock = stock_ingredient.quantity;
+                break;
+            }
+        }
+        shortfall[i] = std::max(0, required[i].required_quantity * servings - in_stock);
+        short_anything = short_anything || shortfall[i] > 0;
+    }
+    if (!short_anything) {
+        return true;
+    }
+
+    // Check that backup covers every shortfall before moving anything
+    std::vector<double> price(required.size(), 0.0);
+    for (size_t i = 0; i < required.size(); ++i) {
+        if (shortfall[i] == 0) {
+            continue;
+        }
+        const Ingredient* backup = backup_ingredients_.find(required[i].name);
+        if (!backup || backup->quantity < shortfall[i]) {
+            VB_METRICS(metrics_.recordBackupMiss(stationMetrics(station), metrics_.dishCounters(station_dish->getName())));
+            return false;
+        }
+        price[i] = backup->price;
+    }
+
+    // Commit
+    OrderTracer::Scope trace("replenishment", nullptr, station);
+    VB_METRICS(metrics_.recordReplenishment(stationMetrics(station), metrics_.dishCounters(station_dish->getName())));
+    for (size_t i = 0; i < required.size(); ++i) {
+        if (shortfall[i] > 0) {
+            logTransfer(station, required[i].name, shortfall[i], price[i]);
+            station->replenishStationIngredients(Ingredient(required[i].name, shortfall[i], 0, price[i]));
+            backup_ingredients_.take(required[i].name, shortfall[i]);
+        }
+    }
+    return true;
+}
+
+/**
+ * Tops up a station from the backup stock so that it covers as many servings of a dish as possible, up to servings.
+ * @return: The number of servings the station's stock covers afterwards.
+ */
+int StationManager::replenishForServings(KitchenStation* station, Dish* station_dish, int servings) {
+    int available = station->servingsAvailable(station_dish->getName());
+    if (available >= servings) {
+        return available;
+    }
+
+    // The largest number of servings that station stock plus backup stock can cover
+    std::vector<Ingredient> stock = station->getIngredientsStock();
+    int coverable = servings;
+    for (const Ingredient& ingredient : station_dish->getIngredients()) {
+        if (ingredient.required_quantity <= 0) {
+            continue;
+        }
+        int total = 0;
+        for (const Ingredient& stock_ingredient : stock) {
+            if (stock_ingredient.name == ingredient.name) {
+                total += stock_ingredient.quantity;
+                break;
+            }
+        }
+        total += backup_ingredients_.getQuantity(ingredient.name);
+        coverable = std::min(coverable, total / ingredient.required_quantity);
+    }
+
+    if (coverable <= available || !replenishShortfall(station, station_dish, coverable)) {
+        return available; // Backup cannot add a single serving
+    }
+    return coverable;
+}
+
+/**
+ * Batch cooking version of processAllDishes.
+ * @post: Identical pending dishes (same name, same accommodated ingredients) are grouped and each group is
+ *        prepared with one replenishment and one stock deduction per station. Unprepared dishes stay in the
+ *        queue in their original order.
+ */
+void StationManager::processCoalescedDishes() {
+    // Drain the queue, remembering each order's position
+    std::vector<Dish*> orders;
+    while (!dish_queue_.empty()) {
+        orders.push_back(dish_queue_.front());
+        dish_queue_.pop();
+    }
+
+    // Group orders by name and accommodated ingredients, in order of first appearance
+    struct Batch {
+        Dish* dish;
+        std::vector<size_t> positions;
+    };
+    std::vector<Batch> batches;
+    std::unordered_map<std::string, size_t> batch_index;
+    for (size_t pos = 0; pos < orders.size(); ++pos) {
+        if (isParked(orders[pos])) {
+            continue;
+        }
+        std::string key = orders[pos]->getName();
+        for (const Ingredient& ingredient : orders[pos]->getIngredients()) {
+            key += '\n' + ingredient.name + ':' + std::to_string(ingredient.required_quantity);
+        }
+        auto found = batch_index.find(key);
+        if (found == batch_index.end()) {
+            batch_index.emplace(key, batches.size());
+            batches.push_back({orders[pos], {pos}});
+        } else {
+            batches[found->second].positions.push_back(pos);
+        }
+    }
+
+    std::vector<bool> prepared(orders.size(), false);
+    for (const Batch& batch : batches) {
+        OrderTracer::Scope trace("routing", batch.dish, batch.dish);
+        const std::string dish_name = batch.dish->getName();
+        int wanted = static_cast<int>(batch.positions.size());
+        int served = 0;
+        logEvent(KitchenEvent::BATCH_STARTED, "", dish_name, wanted);
+        routings_++;
+        VB_METRICS(uint64_t routing_start = MetricsRegistry::now());
+        VB_METRICS(MetricsRegistry::Counters* dish_metrics = metrics_.dishCounters(dish_name));
+
+        std::vector<KitchenStation*> hits;
+        for (KitchenStation* station : rankStations(dish_name)) {
+            if (served == wanted) {
+                break;
+            }
+            routing_probes_++;
+            VB_METRICS(uint64_t attempt_start = MetricsRegistry::now());
+            Dish* station_dish = station->getDish(dish_name);
+
+            int remaining = wanted - served;
+            int available = station->servingsAvailable(dish_name);
+            if (available < remaining) {
+                logEvent(KitchenEvent::BATCH_SHORT, station->getName(), dish_name, remaining);
+                available = replenishForServings(station, station_dish, remaining);
+            }
+
+            int take = std::min(available, remaining);
+            bool cooked = take > 0 && station->prepareDishes(dish_name, take, batch.dish);
+            VB_METRICS(metrics_.recordStationAttempt(stationMetrics(station), cooked, MetricsRegistry::now() - attempt_start));
+            if (cooked) {
+                for (int i = served; i < served + take; ++i) {
+                    prepared[batch.positions[i]] = true;
+                    OrderTracer::completeOrder(orders[batch.positions[i]]);
+                }
+                served += take;
+                logPrepare(station, dish_name, take);
+                addBusyTime(station, dish_name, take);
+                hits.push_back(station);
+                logEvent(KitchenEvent::BATCH_PREPARED, station->getName(), dish_name, take);
+            }
+        }
+        // Reorder only after the walk over the list is finished
+        for (KitchenStation* station : hits) {
+            recordStationHit(station, -1);
+        }
+
+#ifndef VB_DISABLE_METRICS
+        if (served > 0) {
+            metrics_.recordDish(dish_metrics, served, true, MetricsRegistry::now() - routing_start);
+        }
+        if (served < wanted) {
+            metrics_.recordDish(dish_metrics, wanted - served, false, 0);
+        }
+#endif
+        for (int i = served; i < wanted; ++i) {
+            logEvent(KitchenEvent::DISH_NOT_PREPARED, "", dish_name);
+            parkOrder(orders[batch.positions[i]]);
+        }
+        logEvent(KitchenEvent::SEPARATOR, "", "");
+    }
+
+    // Unprepared orders go back in their original order
+    std::vector<uint32_t> prepared_positions;
+    for (size_t pos = 0; pos < orders.size(); ++pos) {
+        if (!prepared[pos]) {
+            dish_queue_.push(orders[pos]);
+        } else {
+            prepared_positions.push_back(static_cast<uint32_t>(pos));
+        }
+    }
+    logQueueRemove(std::move(prepared_positions), dish_queue_.size());
+
+    logEvent(KitchenEvent::QUEUE_PROCESSED, "", "");
+    event_sink_->flush();
+}
+
+/**
+ * Enables or disables whole-queue replenishment planning in processAllDishes.
+ * @param enabled True to plan the allocation of backup stock before preparing anything.
+ * @param objective Whether the plan maximizes the number of completed dishes or their total price.
+ */
+void StationManager::setReplenishmentPlanning(bool enabled, ReplenishmentPlanner::Objective objective) {
+    replenishment_planning_ = enabled;
+    plan_objective_ = objective;
+}
+
+/**
+ * @return: True if processAllDishes plans replenishment for the whole queue; false otherwise.
+ */
+bool StationManager::isReplenishmentPlanning() const {
+    return replenishment_planning_;
+}
+
+/**
+ * @return: The stations in list order.
+ */
+std::vector<KitchenStation*> StationManager::getStations() const {
+    std::vector<KitchenStation*> stations;
+    stations.reserve(item_count_);
+    stations.assign(begin(), end());
+    return stations;
+}
+
+/**
+ * Plans the allocation of backup stock across stations for the current queue, without changing anything.
+ * @return: A ReplenishmentPlan with one station (or nullptr) per queued dish and the backup transfers it needs.
+ */
+ReplenishmentPlan StationManager::planReplenishment() const {
+    std::vector<Dish*> orders;
+    std::queue<Dish*> queue = dish_queue_;
+    while (!queue.empty()) {
+        orders.push_back(queue.front());
+        queue.pop();
+    }
+    return ReplenishmentPlanner(plan_objective_).plan(orders, getStations(), backup_ingredients_);
+}
+
+/**
+ * Planned version of processAllDishes.
+ * @post: The planned backup stock is moved to the stations, every planned dish is prepared at its assigned
+ *        station, and dishes left out of the plan stay in the queue in their original order.
+ */
+void StationManager::processPlannedDishes() {
+    // Parked orders keep their place in the queue but are left out of the plan
+    std::vector<Dish*> queued;
+    std::vector<Dish*> orders;
+    while (!dish_queue_.empty()) {
+        queued.push_back(dish_queue_.front());
+        if (!isParked(dish_queue_.front())) {
+            orders.push_back(dish_queue_.front());
+        }
+        dish_queue_.pop();
+    }
+    ReplenishmentPlan plan;
+    {
+        OrderTracer::Scope trace("routing", nullptr, std::string_view("replenishment plan"));
+        plan = ReplenishmentPlanner(plan_objective_).plan(orders, getStations(), backup_ingredients_);
+    }
+
+    // Move the planned backup stock first; the plan guarantees the backup covers every transfer
+    for (const StockTransfer& transfer : plan.transfers) {
+        OrderTracer::Scope trace("replenishment", nullptr, transfer.station);
+        const Ingredient* backup = backup_ingredients_.find(transfer.ingredient_name);
+        if (backup && backup_ingredients_.take(transfer.ingredient_name, transfer.quantity)) {
+            logTransfer(transfer.station, transfer.ingredient_name, transfer.quantity, backup->price);
+            transfer.station->replenishStationIngredients(Ingredient(transfer.ingredient_name, transfer.quantity, 0, backup->price));
+            VB_METRICS(metrics_.recordReplenishment(stationMetrics(transfer.station), nullptr));
+            logEvent(KitchenEvent::BACKUP_TRANSFER, transfer.station->getName(), transfer.ingredient_name, transfer.quantity);
+        }
+    }
+    if (!plan.transfers.empty()) {
+        logEvent(KitchenEvent::SEPARATOR, "", "");
+    }
+
+    std::vector<bool> prepared_orders(orders.size(), false);
+    for (size_t i = 0; i < orders.size(); ++i) {
+        Dish* dish = orders[i];
+        KitchenStation* station = plan.assignments[i];
+        logEvent(KitchenEvent::DISH_STARTED, "", dish->getName());
+        VB_METRICS(uint64_t attempt_start = MetricsRegistry::now());
+        bool prepared = station && station->prepareDishes(dish->getName(), 1, dish);
+        VB_METRICS(uint64_t latency = MetricsRegistry::now() - attempt_start);
+        if (station) {
+            VB_METRICS(metrics_.recordStationAttempt(stationMetrics(station), prepared, latency));
+        }
+        VB_METRICS(metrics_.recordDish(metrics_.dishCounters(dish->getName()), 1, prepared, latency));
+        if (prepared) {
+            OrderTracer::completeOrder(dish);
+            logPrepare(station, dish->getName(), 1);
+            prepared_orders[i] = true;
+            addBusyTime(station, dish->getName(), 1);
+            logEvent(KitchenEvent::DISH_PREPARED, station->getName(), dish->getName());
+        } else {
+            logEvent(KitchenEvent::DISH_NOT_PREPARED, "", dish->getName());
+            parkOrder(dish);
+        }
+        logEvent(KitchenEvent::SEPARATOR, "", "");
+    }
+
+    // Unprepared and parked orders go back in their original order
+    std::vector<uint32_t> prepared_positions;
+    for (size_t pos = 0, i = 0; pos < queued.size(); ++pos) {
+        if (i < orders.size() && orders[i] == queued[pos]) {
+            if (prepared_orders[i++]) {
+                prepared_positions.push_back(static_cast<uint32_t>(pos));
+                continue;
+            }
+        }
+        dish_queue_.push(queued[pos]);
+    }
+    logQueueRemove(std::move(prepared_positions), dish_queue_.size());
+
+    logEvent(KitchenEvent::QUEUE_PROCESSED, "", "");
+    event_sink_->flush();
+}
+
+/**
+ * Selects how the station list reorders itself after successful prepares.
+ * @param ordering The StationOrdering policy.
+ * @param decay For FREQUENCY_COUNT, the factor by which older prepares count less than newer ones.
+ */
+void StationManager::setStationOrdering(StationOrdering ordering, double decay) {
+    station_ordering_ = ordering;
+    hit_decay_ = (decay > 0.0 && decay <= 1.0) ? decay : 1.0;
+    hit_weight_ = 1.0;
+    station_hits_.clear();
+}
+
+/**
+ * @return: The current StationOrdering policy.
+ */
+StationManager::StationOrdering StationManager::getStationOrdering() const {
+    return station_ordering_;
+}
+
+/**
+ * @return: The number of stations examined while routing dishes.
+ */
+long StationManager::getRoutingProbeCount() const {
+    return routing_probes_;
+}
+
+/**
+ * @return: The number of dishes routed.
+ */
+long StationManager::getRoutingCount() const {
+    return routings_;
+}
+
+/**
+ * Resets the routing probe and routing counters to zero.
+ */
+void StationManager::resetRoutingCounters() {
+    routing_probes_ = 0;
+    routings_ = 0;
+}
+
+/**
+ * Applies the StationOrdering policy after a successful prepare.
+ * @param station The station that prepared a dish.
+ * @param position Its position in the list, or -1 if unknown.
+ */
+void StationManager::recordStationHit(KitchenStation* station, int position) {
+    if (station_ordering_ == FIXED) {
+        return;
+    }
+    if (position < 0) {
+        position = getStationIndex(station->getName());
+        if (position < 0) {
+            return;
+        }
+    }
+
+    if (station_ordering_ == MOVE_TO_FRONT) {
+        if (position > 0) {
+            moveToFront(getNodeAt(position));
+        }
+        return;
+    }
+
+    if (station_ordering_ == TRANSPOSE) {
+        if (position > 0) {
+            // Swap the items of the two nodes instead of relinking them
+            Node<KitchenStation*>* previous = getNodeAt(position - 1);
+            Node<KitchenStation*>* current = previous->getNext();
+            current->setItem(previous->getItem());
+            previous->setItem(station);
+        }
+        return;
+    }
+
+    // FREQUENCY_COUNT: later hits weigh more, which is the same as decaying all earlier hits
+    station_hits_[station] += hit_weight_;
+    hit_weight_ /= hit_decay_;
+    if (hit_weight_ > 1e100) {
+        for (auto& hits : station_hits_) {
+            hits.second /= hit_weight_;
+        }
+        hit_weight_ = 1.0;
+    }
+
+    // Bubble the station forward past every station with a lower score
+    std::vector<Node<KitchenStation*>*> nodes;
+    nodes.reserve(position + 1);
+    Node<KitchenStation*>* node = getHeadNode();
+    for (int i = 0; i <= position && node != nullptr; ++i, node = node->getNext()) {
+        nodes.push_back(node);
+    }
+    double score = station_hits_[station];
+    int i = static_cast<int>(nodes.size()) - 1;
+    while (i > 0) {
+        auto previous = station_hits_.find(nodes[i - 1]->getItem());
+        if (previous != station_hits_.end() && previous->second >= score) {
+            break;
+        }
+        nodes[i]->setItem(nodes[i - 1]->getItem());
+        nodes[i - 1]->setItem(station);
+        i--;
+    }
+}
+
+/**
+ * Selects how dishes carried by several stations are routed.
+ * @param routing The StationRouting policy.
+ */
+void StationManager::setStationRouting(StationRouting routing) {
+    station_routing_ = routing;
+}
+
+/**
+ * @return: The current StationRouting policy.
+ */
+StationManager::StationRouting StationManager::getStationRouting() const {
+    return station_routing_;
+}
+
+/**
+ * @param station_name The name of the station.
+ * @return: The simulated busy time of the station, or 0 if it has prepared nothing.
+ */
+int StationManager::getStationBusyTime(const std::string& station_name) const {
+    KitchenStation* station = findStation(station_name);
+    auto found = station_busy_time_.find(station);
+    return found == station_busy_time_.end() ? 0 : found->second;
+}
+
+/**
+ * Orders the stations carrying a dish by the StationRouting policy.
+ * @param dish_name The name of the dish.
+ * @return: The stations carrying the dish, preferred first.
+ */
+std::vector<KitchenStation*> StationManager::rankStations(const std::string& dish_name) const {
+    struct Candidate {
+        KitchenStation* station;
+        int servings;
+        int busy_time;
+    };
+    std::vector<Candidate> candidates;
+    for (KitchenStation* station : *this) {
+        if (station->getDish(dish_name) == nullptr) {
+            continue;
+        }
+        int servings = station_routing_ == FIRST_FIT ? 0 : station->servingsAvailable(dish_name);
+        auto busy = station_busy_time_.find(station);
+        candidates.push_back({station, servings, busy == station_busy_time_.end() ? 0 : busy->second});
+    }
+
+    if (station_routing_ == MOST_SERVINGS) {
+        std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.servings > b.servings;
+        });
+    } else if (station_routing_ == LEAST_BUSY) {
+        // Stations that can serve from their own stock come first, so backup is only used when they are all dry
+        std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            if ((a.servings > 0) != (b.servings > 0)) {
+                return a.servings > 0;
+            }
+            return a.busy_time < b.busy_time;
+        });
+    }
+
+    std::vector<KitchenStation*> ranked;
+    ranked.reserve(candidates.size());
+    for (const Candidate& candidate : candidates) {
+        ranked.push_back(candidate.station);
+    }
+    return ranked;
+}
+
+/**
+ * @param dish_name The name of the dish.
+ * @return: The station preferred for one serving of the dish, or nullptr if there is none.
+ */
+KitchenStation* StationManager::chooseStation(const std::string& dish_name) const {
+    if (station_routing_ == FIRST_FIT) {
+        return nullptr;
+    }
+    std::vector<KitchenStation*> ranked = rankStations(dish_name);
+    if (ranked.empty() || ranked.front()->servingsAvailable(dish_name) < 1) {
+        return nullptr;
+    }
+    return ranked.front();
+}
+
+/**
+ * Adds the prep time of servings of a dish to the simulated busy time of a station.
+ */
+void StationManager::addBusyTime(KitchenStation* station, const std::string& dish_name, int servings) {
+    Dish* dish = station->getDish(dish_name);
+    if (dish != nullptr) {
+        station_busy_time_[station] += dish->getPrepTime() * servings;
+    }
+}
+
+/**
+ * @return: The metrics registry of this manager.
+ */
+const MetricsRegistry& StationManager::getMetrics() const {
+    return metrics_;
+}
+
+/**
+ * @return: A snapshot of every station and dish counter.
+ */
+MetricsSnapshot StationManager::getMetricsSnapshot() const {
+    return metrics_.snapshot();
+}
+
+/**
+ * Zeroes every metric collected so far.
+ */
+void StationManager::resetMetrics() {
+    metrics_.reset();
+}
+
+/**
+ * @return: The counters of a station, resolved when it joined this manager.
+ */
+MetricsRegistry::Counters* StationManager::stationMetrics(KitchenStation* station) {
+    auto found = station_metrics_.find(station);
+    if (found == station_metrics_.end()) {
+        found = station_metrics_.emplace(station, metrics_.stationCounters(station->getName())).first;
+    }
+    return found->second;
+}
+
+/**
+ * Routes processAllDishes events to a sink.
+ * @param sink The sink to use; nullptr turns logging off.
+ */
+void StationManager::setEventSink(std::shared_ptr<EventSink> sink) {
+    event_sink_ = sink ? sink : std::make_shared<NullEventSink>();
+}
+
+/**
+ * @return: The sink that receives processAllDishes events.
+ */
+std::shared_ptr<EventSink> StationManager::getEventSink() const {
+    return event_sink_;
+}
+
+/**
+ * Sends one event to the sink if its level is accepted.
+ */
+void StationManager::logEvent(KitchenEvent::Type type, std::string_view station, std::string_view dish, int quantity) {
+    if (event_sink_->accepts(KitchenEvent::levelOf(type))) {
+        event_sink_->write(KitchenEvent{type, station, dish, quantity});
+    }
+}
+
+/**
+ * Saves the stations, the dish queue, the backup stock and the settings to a binary snapshot.
+ * @param filename The file to write.
+ * @return: True if the snapshot was written; false otherwise.
+ */
+bool StationManager::saveSnapshot(const std::string& filename) const {
+    SnapshotBuilder builder;
+    for (KitchenStation* station : *this) {
+        if (!builder.addStation(*station)) {
+            return false;
+        }
+    }
+    std::queue<Dish*> queue = dish_queue_;
+    while (!queue.empty()) {
+        if (!builder.addQueuedDish(*queue.front())) {
+            return false;
+        }
+        queue.pop();
+    }
+    for (const Ingredient& ingredient : backup_ingredients_.getIngredients()) {
+        builder.addBackupIngredient(ingredient);
+    }
+
+    SnapshotHeader& settings = builder.settings();
+    settings.batch_cooking = batch_cooking_;
+    settings.replenishment_planning = replenishment_planning_;
+    settings.plan_objective = static_cast<uint8_t>(plan_objective_);
+    settings.station_ordering = static_cast<uint8_t>(station_ordering_);
+    settings.station_routing = static_cast<uint8_t>(station_routing_);
+    settings.hit_decay = hit_decay_;
+    settings.wal_sequence = wal_ ? wal_->lastSequence() : 0;
+    return builder.write(filename);
+}
+
+/**
+ * Restores the state saved by saveSnapshot.
+ * @param filename The snapshot file.
+ * @return: True if the snapshot was restored; false otherwise.
+ */
+bool StationManager::restoreSnapshot(const std::string& filename) {
+    if (!isEmpty()) {
+        return false;
+    }
+    SnapshotImage image;
+    if (!image.open(filename)) {
+        return false;
+    }
+    restoreImage(image);
+    return true;
+}
+
+/**
+ * Rebuilds the stations, queue, backup stock and settings from a validated snapshot, without logging.
+ */
+void StationManager::restoreImage(const SnapshotImage& image) {
+    std::shared_ptr<WriteAheadLog> log = std::move(wal_);
+    const SnapshotHeader& header = image.header();
+
+    for (uint32_t i = 0; i < header.station_count; ++i) {
+        const SnapshotStation& record = image.stations()[i];
+        KitchenStation* station = new KitchenStation(std::string(image.str(record.name)));
+        for (uint32_t d = 0; d < record.dish_count; ++d) {
+            station->assignDishToStation(image.makeDish(image.dishes()[record.first_dish + d]));
+        }
+        for (uint32_t k = 0; k < record.stock_count; ++k) {
+            station->replenishStationIngredients(image.makeIngredient(image.ingredients()[record.first_stock + k]));
+        }
+        push_back(station);
+        watchStation(station);
+        VB_METRICS(station_metrics_[station] = metrics_.stationCounters(station->getName()));
+    }
+
+    clearDishQueue();
+    for (uint32_t i = 0; i < header.queue_count; ++i) {
+        dish_queue_.push(image.makeDish(image.dishes()[header.queue_first + i]));
+    }
+    metrics_.observeQueueDepth(dish_queue_.size());
+
+    backup_ingredients_.clear();
+    for (uint32_t i = 0; i < header.backup_count; ++i) {
+        backup_ingredients_.add(image.makeIngredient(image.ingredients()[header.backup_first + i]));
+    }
+
+    batch_cooking_ = header.batch_cooking != 0;
+    replenishment_planning_ = header.replenishment_planning != 0;
+    plan_objective_ = static_cast<ReplenishmentPlanner::Objective>(header.plan_objective);
+    setStationOrdering(static_cast<StationOrdering>(header.station_ordering), header.hit_decay);
+    station_routing_ = static_cast<StationRouting>(header.station_routing);
+    wal_ = std::move(log);
+}
+
+/**
+ * Records every later mutation of the queue and stock in a write-ahead log.
+ * @param log The log; nullptr stops logging.
+ */
+void StationManager::setWriteAheadLog(std::shared_ptr<WriteAheadLog> log) {
+    wal_ = std::move(log);
+}
+
+/**
+ * @return: The write-ahead log, or nullptr if mutations are not logged.
+ */
+std::shared_ptr<WriteAheadLog> StationManager::getWriteAheadLog() const {
+    return wal_;
+}
+
+/**
+ * Restores a snapshot and replays the write-ahead log records appended after it.
+ * @return: True if the snapshot was restored and every record was replayed; false otherwise.
+ */
+bool StationManager::recover(const std::string& snapshot_filename, const std::string& log_filename) {
+    uint64_t after_sequence = 0;
+    if (!snapshot_filename.empty()) {
+        SnapshotImage image;
+        if (!isEmpty() || !image.open(snapshot_filename)) {
+            return false;
+        }
+        restoreImage(image);
+        after_sequence = image.header().wal_sequence;
+    }
+
+    std::vector<WalRecord> records;
+    if (!WriteAheadLog::readAll(log_filename, records, after_sequence)) {
+        return false;
+    }
+    std::shared_ptr<WriteAheadLog> log = std::move(wal_);
+    bool replayed = true;
+    for (const WalRecord& record : records) {
+        if (!applyLogRecord(record)) {
+            replayed = false;
+            break;
+        }
+    }
+    wal_ = std::move(log);
+    return replayed;
+}
+
+/**
+ * Applies one write-ahead log record. Every record is deterministic given the state it was logged in.
+ */
+bool StationManager::applyLogRecord(const WalRecord& record) {
+    KitchenStation* station = nullptr;
+    if (record.type == WalRecord::PREPARE || record.type == WalRecord::STOCK_ADD || record.type == WalRecord::BACKUP_TRANSFER) {
+        station = findStation(record.station);
+        if (station == nullptr) {
+            return false;
+        }
+    }
+
+    switch (record.type) {
+        case WalRecord::ENQUEUE: {
+            Dish* dish = record.makeDish();
+            if (dish == nullptr) {
+                return false;
+            }
+            dish_queue_.push(dish);
+            metrics_.observeQueueDepth(dish_queue_.size());
+            return true;
+        }
+        case WalRecord::QUEUE_REMOVE: {
+            // The record must describe this queue: ascending positions inside a queue of the logged length
+            if (record.quantity < 0 || static_cast<size_t>(record.quantity) != dish_queue_.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < record.positions.size(); ++i) {
+                if (record.positions[i] >= dish_queue_.size() || (i > 0 && record.positions[i] <= record.positions[i - 1])) {
+                    return false;
+                }
+            }
+
+            // Prepared dishes leave the queue; the replayed copies belong to no one else, so they are freed
+            std::queue<Dish*> kept;
+            size_t next = 0;
+            for (uint32_t position = 0; !dish_queue_.empty(); ++position) {
+                Dish* dish = dish_queue_.front();
+                dish_queue_.pop();
+                if (next < record.positions.size() && record.positions[next] == position) {
+                    delete dish;
+                    next++;
+                } else {
+                    kept.push(dish);
+                }
+            }
+            dish_queue_.swap(kept);
+            return true;
+        }
+        case WalRecord::QUEUE_CLEAR:
+            clearDishQueue();
+            return true;
+        case WalRecord::PREPARE:
+            if (record.quantity == 0 ? !station->prepareDish(record.dish) : !station->prepareDishes(record.dish, record.quantity)) {
+                return false;
+            }
+            addBusyTime(station, record.dish, std::max(record.quantity, 1));
+            return true;
+        case WalRecord::STOCK_ADD:
+            station->replenishStationIngredients(record.ingredient);
+            return true;
+        case WalRecord::BACKUP_TRANSFER:
+            station->replenishStationIngredients(Ingredient(record.ingredient.name, record.ingredient.quantity, 0, record.ingredient.price));
+            backup_ingredients_.take(record.ingredient.name, record.ingredient.quantity);
+            return true;
+        case WalRecord::BACKUP_ADD:
+            backup_ingredients_.add(record.ingredient);
+            return true;
+        case WalRecord::BACKUP_CLEAR:
+            backup_ingredients_.clear();
+            return true;
+        case WalRecord::STATION_MERGE:
+            return mergeStations(record.station, record.merged_station);
+    }
+    return false;
+}
+
+/**
+ * Logs a dish joining the back of the queue.
+ */
+void StationManager::logEnqueue(const Dish& dish) {
+    if (wal_) {
+        WalRecord record(WalRecord::ENQUEUE);
+        record.setDish(dish);
+        wal_->append(record);
+    }
+}
+
+/**
+ * Logs a prepare of servings of a dish at a station; servings 0 stands for one KitchenStation::prepareDish.
+ */
+void StationManager::logPrepare(KitchenStation* station, const std::string& dish_name, int servings) {
+    if (wal_) {
+        WalRecord record(WalRecord::PREPARE);
+        record.station = station->getName();
+        record.dish = dish_name;
+        record.quantity = servings;
+        wal_->append(record);
+    }
+}
+
+/**
+ * Logs a transfer of quantity of an ingredient from backup to a station.
+ */
+void StationManager::logTransfer(KitchenStation* station, const std::string& ingredient_name, int quantity, double price) {
+    if (wal_) {
+        WalRecord record(WalRecord::BACKUP_TRANSFER);
+        record.station = station->getName();
+        record.ingredient = Ingredient(ingredient_name, quantity, 0, price);
+        wal_->append(record);
+    }
+}
+
+/**
+ * Logs the removal of the prepared dishes at positions from the queue.
+ * @param kept The number of queued dishes that are not removed.
+ */
+void StationManager::logQueueRemove(std::vector<uint32_t> positions, size_t kept) {
+    if (wal_ && !positions.empty()) {
+        WalRecord record(WalRecord::QUEUE_REMOVE);
+        record.quantity = static_cast<int>(kept + positions.size());
+        record.positions = std::move(positions);
+        wal_->append(record);
+    }
+}
+
+/**
+ * Enables or disables parking of orders that cannot be prepared.
+ * @param enabled True to park failed orders until stock they lack arrives.
+ */
+void StationManager::setOrderParking(bool enabled) {
+    order_parking_ = enabled;
+    parked_orders_->clear();
+}
+
+/**
+ * @return: True if failed orders are parked until stock they lack arrives; false otherwise.
+ */
+bool StationManager::isOrderParking() const {
+    return order_parking_;
+}
+
+/**
+ * @return: The number of queued orders that are parked.
+ */
+size_t StationManager::getParkedOrderCount() const {
+    return parked_orders_->orders.size();
+}
+
+/**
+ * Parks an order if every station carrying its dish lacks an ingredient even counting the backup stock.
+ * @return: True if the order was parked; false otherwise.
+ */
+bool StationManager::parkOrder(Dish* dish) {
+    if (!order_parking_) {
+        return false;
+    }
+    const std::string dish_name = dish->getName();
+    std::vector<std::string> missing;
+    bool carried = false;
+    for (KitchenStation* station : *this) {
+        Dish* station_dish = station->getDish(dish_name);
+        if (station_dish == nullptr) {
+            continue;
+        }
+        carried = true;
+        std::vector<Ingredient> stock = station->getIngredientsStock();
+        bool short_anything = false;
+        for (const Ingredient& ingredient : station_dish->getIngredients()) {
+            int total = backup_ingredients_.getQuantity(ingredient.name);
+            for (const Ingredient& stock_ingredient : stock) {
+                if (stock_ingredient.name == ingredient.name) {
+                    total += stock_ingredient.quantity;
+                    break;
+                }
+            }
+            if (total < ingredient.required_quantity) {
+                missing.push_back(ingredient.name);
+                short_anything = true;
+            }
+        }
+        if (!short_anything) {
+            return false; // This station could prepare it, so it failed for another reason; retry it next time
+        }
+    }
+    if (!carried) {
+        return false;
+    }
+
+    std::sort(missing.begin(), missing.end());
+    missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+    parked_orders_->orders.insert(dish);
+    for (const std::string& ingredient_name : missing) {
+        std::vector<Dish*>& waiting = parked_orders_->waiting_on[ingredient_name];
+        waiting.push_back(dish);
+        // Drop entries of orders woken through another ingredient once they outnumber the parked orders
+        if (waiting.size() > 2 * parked_orders_->orders.size() + 16) {
+            std::unordered_set<Dish*> kept;
+            waiting.erase(std::remove_if(waiting.begin(), waiting.end(), [this, &kept](Dish* waiting_dish) {
+                return !isParked(waiting_dish) || !kept.insert(waiting_dish).second;
+            }), waiting.end());
+        }
+    }
+    return true;
+}
+
+/**
+ * @return: True if the order is parked.
+ */
+bool StationManager::isParked(Dish* dish) const {
+    return !parked_orders_->orders.empty() && parked_orders_->orders.count(dish) > 0;
+}
+
+/**
+ * Lets a station wake parked orders when stock is added to it.
+ */
+void StationManager::watchStation(KitchenStation* station) {
+    std::weak_ptr<ParkedOrders> parked = parked_orders_;
+    station->setStockListener([parked](const std::string& ingredient_name) {
+        if (std::shared_ptr<ParkedOrders> orders = parked.lock()) {
+            orders->wake(ingredient_name);
+        }
+    });
+}
+
+// Unparks every order waiting for an ingredient
+void StationManager::ParkedOrders::wake(const std::string& ingredient_name) {
+    if (orders.empty()) {
+        return;
+    }
+    auto found = waiting_on.find(ingredient_name);
+    if (found == waiting_on.end()) {
+        return;
+    }
+    for (Dish* dish : found->second) {
+        orders.erase(dish);
+    }
+    waiting_on.erase(found);
+}
+
+void StationManager::ParkedOrders::clear() {
+    orders.clear();
+    waiting_on.clear();
+}
@@ -6,14 +6,41 @@
 #include "LinkedList.hpp"
 #include "KitchenStation.hpp"
 #include "Dish.hpp"
+#include "IngredientWarehouse.hpp"
+#include "ReplenishmentPlanner.hpp"
+#include "StationMetrics.hpp"
+#include "EventLog.hpp"
+#include "OrderTracer.hpp"
+#include "WriteAheadLog.hpp"
+#include <memory>
 #include <queue>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+class SnapshotImage;
 
 class StationManager : public LinkedList<KitchenStation*> {
     
 public:
+    /**
+     * How the station list adapts to the stations that actually prepare dishes.
+     * FIXED keeps the list as built; MOVE_TO_FRONT moves a station to the front after each successful prepare;
+     * TRANSPOSE swaps it with its predecessor; FREQUENCY_COUNT keeps the list sorted by a decayed count of
+     * successful prepares.
+     */
+    enum StationOrdering { FIXED, MOVE_TO_FRONT, TRANSPOSE, FREQUENCY_COUNT };
+
+    /**
+     * How a dish is routed when several stations carry it.
+     * FIRST_FIT uses the first station in list order; MOST_SERVINGS prefers the station that can serve the most
+     * portions from its own stock; LEAST_BUSY prefers the station with the least simulated busy time that can
+     * serve the dish from its own stock.
+     */
+    enum StationRouting { FIRST_FIT, MOST_SERVINGS, LEAST_BUSY };
+
     /**
      * Default Constructor
      * @post: Initializes an empty station manager.
@@ -56,8 +83,13 @@ public:
      * Merges the dishes and ingredients of two specified stations.
      * @param station_name1 The name of the first station.
      * @param station_name2 The name of the second station.
-     * @post: The second station is removed from the list, and its contents are added to the first station.
-     * @return: True if both stations were found and merged; false otherwise.
+     * @post: The second station's dishes and stock are moved into the first station without copying: a dish whose
+     * name the first station already carries is deleted if it is a distinct object and kept once if both stations
+     * hold the same Dish*, stock of the same ingredient is combined in one hashed pass, and
+     * the second station's busy time is added to the first's. The second station is then removed from the list
+     * and deleted, so the caller must not use or delete it afterwards. The merge is written to the write-ahead
+     * log, if one is set, so recover() replays it before the records that use the merged stock.
+     * @return: True if both stations were found, are different, and were merged; false otherwise.
      */
     bool mergeStations(const std::string& station_name1, const std::string& station_name2);
 
@@ -163,16 +195,28 @@ public:
      * @param station_name The name of the station.
      * @param ingredient_name The name of the ingredient to replenish.
      * @param quantity The amount to replenish.
-     * @return: True if the ingredient was replenished successfully; false otherwise.
+     * @return: True if the ingredient was replenished successfully; false if quantity is not positive, the station
+     * does not exist or the backup stock holds less than quantity, in which case nothing changes.
      * @post: The ingredient stock at the station is updated, and the backup stock is adjusted accordingly.
      */
     bool replenishStationIngredientFromBackup(const std::string& station_name, const std::string& ingredient_name, int quantity);
 
+    /**
+     * Replenishes a station from the backup stock with everything it lacks to prepare one serving of a dish.
+     * @param station_name The name of the station.
+     * @param dish_name The name of a dish assigned to the station.
+     * @return: True if the station can prepare the dish afterwards; false if the station or dish was not found
+     *          or the backup stock cannot cover the whole shortfall.
+     * @post: The shortfall of every ingredient is computed first and checked against the backup stock in one pass.
+     *        Either all of it moves from backup to the station, or nothing moves.
+     */
+    bool replenishForDish(const std::string& station_name, const std::string& dish_name);
+
     /**
      * Adds a batch of ingredients to the backup stock.
      * @param ingredients A vector of Ingredient objects to add to the backup stock.
-     * @return: True if all ingredients were added successfully; false otherwise.
-     * @post: The backup stock is updated with the provided ingredients.
+     * @return: True if all ingredients were added successfully; false otherwise (including an empty batch).
+     * @post: Each ingredient is merged into the backup stock: existing quantities are increased, new ingredients are added.
      */
     bool addBackupIngredients(const std::vector<Ingredient>& ingredients);
 
@@ -186,10 +230,21 @@ public:
 
     /**
      * Clears all ingredients from the backup stock.
-     * @post: The backup_ingredients_ vector is emptied.
+     * @post: The backup_ingredients_ warehouse is emptied.
      */
     void clearBackupIngredients();
 
+    /**
+     * @param ingredient_name The name of an ingredient.
+     * @return: The quantity of the ingredient in the backup stock (0 if none), without scanning.
+     */
+    int getBackupQuantity(const std::string& ingredient_name) const;
+
+    /**
+     * @return: The total value (quantity times price) of the backup stock, without scanning.
+     */
+    double getBackupStockValue() const;
+
     /**
      * Processes all dishes in the queue and displays detailed results.
     * @pre: None.
@@ -203,6 +258,197 @@ in the same order
      */
     void processAllDishes();
 
+    /**
+     * Enables or disables batch cooking in processAllDishes.
+     * @param enabled True to coalesce identical queued dishes before preparing them.
+     * @post: When enabled, processAllDishes groups pending dishes that have the same name and the same
+     * (accommodated) ingredients. Each group is routed once: the combined shortfall is replenished from
+     * backup in one move per ingredient and the combined requirement is deducted in one transaction.
+     * Orders are served in queue order within a group; unprepared orders keep their original queue order.
+     */
+    void setBatchCooking(bool enabled);
+
+    /**
+     * @return: True if processAllDishes coalesces identical dishes; false otherwise.
+     */
+    bool isBatchCooking() const;
+
+    /**
+     * Enables or disables whole-queue replenishment planning in processAllDishes.
+     * @param enabled True to plan the allocation of backup stock before preparing anything.
+     * @param objective Whether the plan maximizes the number of completed dishes or their total price.
+     * @post: When enabled, processAllDishes computes a ReplenishmentPlan for the entire queue, moves the planned
+     * backup stock to the stations, and then prepares every planned dish at its assigned station in queue order.
+     * Dishes left out of the plan stay in the queue in their original order. Planning takes precedence over batch cooking.
+     */
+    void setReplenishmentPlanning(bool enabled, ReplenishmentPlanner::Objective objective = ReplenishmentPlanner::MAXIMIZE_DISHES);
+
+    /**
+     * @return: True if processAllDishes plans replenishment for the whole queue; false otherwise.
+     */
+    bool isReplenishmentPlanning() const;
+
+    /**
+     * Enables or disables parking of orders that cannot be prepared.
+     * @param enabled True to park failed orders until stock they lack arrives.
+     * @post: When enabled, an order that fails in prepareNextDish or processAllDishes because every station
+     * carrying its dish lacks some ingredient even counting the backup stock is parked under those ingredients.
+     * It stays in the queue in its place, but later calls skip it without probing any station until stock of
+     * one of its missing ingredients is added: through replenishStationIngredients on a station of this
+     * manager, addBackupIngredient(s), or a merge. Assigning a dish through this manager wakes every parked
+     * order. Retrying then costs in proportion to the stock changes, not to the backlog.
+     */
+    void setOrderParking(bool enabled);
+
+    /**
+     * @return: True if failed orders are parked until stock they lack arrives; false otherwise.
+     */
+    bool isOrderParking() const;
+
+    /**
+     * @return: The number of queued orders that are parked.
+     */
+    size_t getParkedOrderCount() const;
+
+    /**
+     * Plans the allocation of backup stock across stations for the current queue, without changing anything.
+     * @return: A ReplenishmentPlan with one station (or nullptr) per queued dish and the backup transfers it needs.
+     */
+    ReplenishmentPlan planReplenishment() const;
+
+    /**
+     * Selects how the station list reorders itself after successful prepares.
+     * @param ordering The StationOrdering policy (FIXED by default).
+     * @param decay For FREQUENCY_COUNT, the factor (0 < decay <= 1) by which older prepares count less than newer ones.
+     * @post: prepareNextDish and processAllDishes reorder the list after each successful prepare, so busy stations
+     * are probed first. Switching policy resets the frequency counts.
+     */
+    void setStationOrdering(StationOrdering ordering, double decay = 0.99);
+
+    /**
+     * @return: The current StationOrdering policy.
+     */
+    StationOrdering getStationOrdering() const;
+
+    /**
+     * Selects how dishes carried by several stations are routed.
+     * @param routing The StationRouting policy (FIRST_FIT by default).
+     * @post: prepareNextDish and processAllDishes try the preferred station first and fall back to list order,
+     * so stock and backup trips spread across the stations carrying a dish.
+     */
+    void setStationRouting(StationRouting routing);
+
+    /**
+     * @return: The current StationRouting policy.
+     */
+    StationRouting getStationRouting() const;
+
+    /**
+     * @param station_name The name of the station.
+     * @return: The simulated busy time of the station: the summed prep time of every dish it prepared through
+     * this manager, or 0 if it has prepared none.
+     */
+    int getStationBusyTime(const std::string& station_name) const;
+
+    /**
+     * @return: The number of stations examined while routing dishes in prepareNextDish and processAllDishes.
+     */
+    long getRoutingProbeCount() const;
+
+    /**
+     * @return: The number of dishes routed by prepareNextDish and processAllDishes.
+     * getRoutingProbeCount() / getRoutingCount() is the average number of probes per dish.
+     */
+    long getRoutingCount() const;
+
+    /**
+     * Resets the routing probe and routing counters to zero.
+     */
+    void resetRoutingCounters();
+
+    /**
+     * @return: The metrics registry: per-station and per-dish attempt, prepare, failure, replenishment and
+     * backup-miss counters, prepare latency histograms and the queue high-water mark.
+     * Counters are relaxed atomics and new entries are created under the registry's mutex, so a monitoring
+     * thread may call snapshot() while this manager works. Calls that record run on one thread at a time
+     * (OrderPipeline holds its mutex around them); resetMetrics must not overlap them.
+     */
+    const MetricsRegistry& getMetrics() const;
+
+    /**
+     * @return: A snapshot of every metric, exportable with toJson() or toPrometheus().
+     * Empty when built with -DVB_DISABLE_METRICS.
+     */
+    MetricsSnapshot getMetricsSnapshot() const;
+
+    /**
+     * Zeroes every metric collected so far.
+     */
+    void resetMetrics();
+
+    /**
+     * Routes the events of processAllDishes to a sink.
+     * @param sink A NullEventSink, TextEventSink, AsyncFileEventSink or any other EventSink; nullptr turns
+     * logging off. The default is a TextEventSink on std::cout, which prints the same text as always but
+     * flushes once per processAllDishes call instead of once per line.
+     * @post: The sink is flushed at the end of every processAllDishes call.
+     */
+    void setEventSink(std::shared_ptr<EventSink> sink);
+
+    /**
+     * @return: The sink that receives processAllDishes events.
+     */
+    std::shared_ptr<EventSink> getEventSink() const;
+
+    /**
+     * Saves the stations (with their dishes and stock), the dish queue, the backup stock and the processing
+     * settings to a versioned binary snapshot (see StationSnapshot.hpp).
+     * @param filename The file to write; it is replaced atomically.
+     * @return: True if the snapshot was written; false otherwise. A dish that is not an Appetizer, MainCourse or
+     * Dessert is restored as a PlainDish.
+     */
+    bool saveSnapshot(const std::string& filename) const;
+
+    /**
+     * Restores the state saved by saveSnapshot. The file is memory-mapped and read in place.
+     * @param filename The snapshot file.
+     * @pre: The manager has no stations.
+     * @post: The stations are rebuilt and added in their saved order; like any station added with addStation,
+     * they are owned by the caller. The dish queue and backup stock are replaced by the saved ones.
+     * @return: True if the snapshot was restored; false if the manager has stations or the file is missing
+     * or invalid, in which case nothing changes.
+     */
+    bool restoreSnapshot(const std::string& filename);
+
+    /**
+     * Records every later mutation of the dish queue, station stock and backup stock in a write-ahead log:
+     * queued dishes, dishes prepared (and removed from the queue) by prepareNextDish, processAllDishes and
+     * prepareDishAtStation, stock added to stations, backup transfers, backup additions and clears, and
+     * merged stations.
+     * @param log The log to append to; nullptr stops logging. Keep appending to the same log file across
+     * snapshots, since saveSnapshot records the sequence number of the last record the snapshot includes.
+     * @post: Stations added or removed and dishes assigned to stations are not logged; take a snapshot
+     * after changing the station layout. Station order and routing statistics are not logged either, so after
+     * recovery the list order may differ from the order before the crash.
+     */
+    void setWriteAheadLog(std::shared_ptr<WriteAheadLog> log);
+
+    /**
+     * @return: The write-ahead log, or nullptr if mutations are not logged.
+     */
+    std::shared_ptr<WriteAheadLog> getWriteAheadLog() const;
+
+    /**
+     * Restores a snapshot and replays the write-ahead log records appended after it.
+     * @param snapshot_filename The last snapshot, or "" to replay the whole log onto the current state.
+     * @param log_filename The log; records after its first torn or corrupt record are ignored.
+     * @pre: The manager has no stations, unless snapshot_filename is "".
+     * @post: Replayed mutations are not logged again. Replay stops at a record that cannot be applied, such as
+     * one naming a station that does not exist.
+     * @return: True if the snapshot was restored and every record was replayed; false otherwise.
+     */
+    bool recover(const std::string& snapshot_filename, const std::string& log_filename);
+
 private:
     /**
      * Helper function to get index of a station by name.
@@ -210,8 +456,160 @@ private:
      * @return: The index of the station if found; -1 otherwise.
      */
     int getStationIndex(const std::string& station_name) const;
+
+    /**
+     * Batch cooking version of processAllDishes (see setBatchCooking).
+     */
+    void processCoalescedDishes();
+
+    /**
+     * Planned version of processAllDishes (see setReplenishmentPlanning).
+     */
+    void processPlannedDishes();
+
+    /**
+     * @return: The stations in list order.
+     */
+    std::vector<KitchenStation*> getStations() const;
+
+    /**
+     * Applies the StationOrdering policy after a successful prepare.
+     * @param station The station that prepared a dish.
+     * @param position Its position in the list, or -1 if unknown.
+     */
+    void recordStationHit(KitchenStation* station, int position);
+
+    /**
+     * Orders the stations carrying a dish by the StationRouting policy.
+     * @param dish_name The name of the dish.
+     * @return: The stations carrying the dish, preferred first; list order breaks ties.
+     */
+    std::vector<KitchenStation*> rankStations(const std::string& dish_name) const;
+
+    /**
+     * @param dish_name The name of the dish.
+     * @return: The station the StationRouting policy prefers for one serving of the dish, or nullptr if the
+     * policy is FIRST_FIT or no station can serve it from its own stock.
+     */
+    KitchenStation* chooseStation(const std::string& dish_name) const;
+
+    /**
+     * Adds the prep time of servings of a dish to the simulated busy time of a station.
+     */
+    void addBusyTime(KitchenStation* station, const std::string& dish_name, int servings);
+
+    /**
+     * Sends one event to the sink if its level is accepted, so rejected events cost no formatting.
+     */
+    void logEvent(KitchenEvent::Type type, std::string_view station, std::string_view dish, int quantity = 0);
+
+    /**
+     * Tops up a station from the backup stock so that it covers as many servings of a dish as possible, up to servings.
+     * @param station The station carrying the dish.
+     * @param station_dish The station's copy of the dish, whose ingredients are used.
+     * @param servings The number of servings wanted.
+     * @post: The shortfall for the largest coverable number of servings is moved from backup to the station,
+     * one move per ingredient. Nothing is moved if not even one more serving can be covered.
+     * @return: The number of servings the station's stock covers afterwards.
+     */
+    int replenishForServings(KitchenStation* station, Dish* station_dish, int servings);
+
+    /**
+     * Transactional replenishment behind replenishForDish.
+     * @param station The station carrying the dish.
+     * @param station_dish The station's copy of the dish, whose ingredients are used.
+     * @param servings The number of servings the station must cover.
+     * @post: Either the whole shortfall for servings is moved from backup to the station, or nothing is moved.
+     * @return: True if the station's stock covers the servings afterwards; false otherwise.
+     */
+    bool replenishShortfall(KitchenStation* station, Dish* station_dish, int servings);
+
+    /**
+     * Rebuilds the stations, queue, backup stock and settings from a validated snapshot (see restoreSnapshot).
+     */
+    void restoreImage(const SnapshotImage& image);
+
+    /**
+     * Applies one write-ahead log record without logging it.
+     * @return: False if the record names a missing station or holds an invalid dish.
+     */
+    bool applyLogRecord(const WalRecord& record);
+
+    /**
+     * Orders parked until stock they lack arrives. Stations hold only a weak reference through their stock
+     * listener, so stations may outlive the manager.
+     */
+    struct ParkedOrders {
+        std::unordered_set<Dish*> orders;
+        std::unordered_map<std::string, std::vector<Dish*>> waiting_on; ///< Parked orders by missing ingredient; may hold woken ones
+
+        void wake(const std::string& ingredient_name);
+        void clear();
+    };
+
+    /**
+     * Parks an order if every station carrying its dish lacks an ingredient even counting the backup stock.
+     * @return: True if the order was parked; false if parking is off, no station carries the dish, or some
+     * station could still prepare it.
+     */
+    bool parkOrder(Dish* dish);
+
+    /**
+     * @return: True if the order is parked.
+     */
+    bool isParked(Dish* dish) const;
+
+    /**
+     * Lets a station wake parked orders when stock is added to it.
+     */
+    void watchStation(KitchenStation* station);
+
+    /**
+     * @return: The metrics counters of a station, resolved once when it joined this manager. A station renamed
+     * after that keeps recording under its old name.
+     */
+    MetricsRegistry::Counters* stationMetrics(KitchenStation* station);
+
+    /**
+     * Logs a dish joining the back of the queue.
+     */
+    void logEnqueue(const Dish& dish);
+
+    /**
+     * Logs a prepare of servings of a dish at a station; servings 0 stands for one KitchenStation::prepareDish.
+     */
+    void logPrepare(KitchenStation* station, const std::string& dish_name, int servings);
+
+    /**
+     * Logs a transfer of quantity of an ingredient from backup to a station.
+     */
+    void logTransfer(KitchenStation* station, const std::string& ingredient_name, int quantity, double price);
+
+    /**
+     * Logs the removal of the prepared dishes at positions from the queue.
+     * @param kept The number of queued dishes that are not removed.
+     */
+    void logQueueRemove(std::vector<uint32_t> positions, size_t kept);
+
     std::queue<Dish*> dish_queue_; ///< Queue of dishes awaiting preparation.
-    std::vector<Ingredient> backup_ingredients_; ///< Backup ingredients for stations.
+    IngredientWarehouse backup_ingredients_; ///< Backup ingredients for stations, keyed by name.
+    bool batch_cooking_; ///< True if processAllDishes coalesces identical dishes.
+    bool replenishment_planning_; ///< True if processAllDishes plans replenishment for the whole queue.
+    ReplenishmentPlanner::Objective plan_objective_; ///< What the replenishment plan maximizes.
+    StationOrdering station_ordering_; ///< How the station list adapts to successful prepares.
+    double hit_decay_; ///< Decay factor of the FREQUENCY_COUNT scores.
+    double hit_weight_; ///< Weight of the next hit; grows by 1 / hit_decay_ per hit instead of decaying every score.
+    std::unordered_map<KitchenStation*, double> station_hits_; ///< Decayed count of successful prepares per station.
+    StationRouting station_routing_; ///< How dishes carried by several stations are routed.
+    std::unordered_map<KitchenStation*, int> station_busy_time_; ///< Simulated busy time per station.
+    MetricsRegistry metrics_; ///< Per-station and per-dish counters and latency histograms.
+    std::unordered_map<KitchenStation*, MetricsRegistry::Counters*> station_metrics_; ///< Counters of each station, resolved when it is added.
+    std::shared_ptr<EventSink> event_sink_; ///< Receives the events of processAllDishes.
+    std::shared_ptr<WriteAheadLog> wal_; ///< Receives every mutation of the queue and stock, if set.
+    long routing_probes_; ///< Stations examined while routing.
+    long routings_; ///< Dishes routed.
+    bool order_parking_; ///< True if failed orders are parked until stock they lack arrives.
+    std::shared_ptr<ParkedOrders> parked_orders_; ///< Shared with the stock listeners of the stations.
 };
 
 #endif // STATIONMANAGER_HPP
\ No newline at end of file
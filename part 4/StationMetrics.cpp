@@ -0,0 +1,190 @@
+// StationMetrics.cpp contains the snapshot and export side of the MetricsRegistry; recording is inline in the header.
+#include "StationMetrics.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// Escapes a name for a JSON string or a Prometheus label value
+std::string escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        if (c == '\n') {
+            escaped += "\\n";
+            continue;
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+void writeHistogramJson(std::ostringstream& out, const MetricsSnapshot::Histogram& histogram) {
+    out << "{\"count\": " << histogram.count << ", \"sum_ns\": " << histogram.sum_ns << ", \"buckets\": [";
+    for (size_t i = 0; i < histogram.counts.size(); ++i) {
+        out << (i ? ", " : "") << "{\"le_ns\": ";
+        if (i < histogram.upper_bounds_ns.size()) {
+            out << histogram.upper_bounds_ns[i];
+        } else {
+            out << "null";
+        }
+        out << ", \"count\": " << histogram.counts[i] << "}";
+    }
+    out << "]}";
+}
+
+void writeEntriesJson(std::ostringstream& out, const std::vector<MetricsSnapshot::Entry>& entries) {
+    out << "[";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const MetricsSnapshot::Entry& entry = entries[i];
+        out << (i ? ",\n    " : "\n    ") << "{\"name\": \"" << escape(entry.name) << "\", \"attempted\": " << entry.attempted
+            << ", \"prepared\": " << entry.prepared << ", \"failed\": " << entry.failed
+            << ", \"replenishments\": " << entry.replenishments << ", \"backup_misses\": " << entry.backup_misses
+            << ", \"prepare_latency\": ";
+        writeHistogramJson(out, entry.prepare_latency);
+        out << "}";
+    }
+    out << (entries.empty() ? "]" : "\n  ]");
+}
+
+void writeEntriesPrometheus(std::ostringstream& out, const std::vector<MetricsSnapshot::Entry>& entries, const std::string& kind) {
+    const std::string prefix = "vb_" + kind + "_";
+    const struct {
+        const char* name;
+        long MetricsSnapshot::Entry::*field;
+    } counters[] = {
+        {"attempted_total", &MetricsSnapshot::Entry::attempted},
+        {"prepared_total", &MetricsSnapshot::Entry::prepared},
+        {"failed_total", &MetricsSnapshot::Entry::failed},
+        {"replenishments_total", &MetricsSnapshot::Entry::replenishments},
+        {"backup_misses_total", &MetricsSnapshot::Entry::backup_misses},
+    };
+    for (const auto& counter : counters) {
+        out << "# TYPE " << prefix << counter.name << " counter\n";
+        for (const MetricsSnapshot::Entry& entry : entries) {
+            out << prefix << counter.name << "{" << kind << "=\"" << escape(entry.name) << "\"} " << entry.*counter.field << "\n";
+        }
+    }
+
+    out << "# TYPE " << prefix << "prepare_latency_seconds histogram\n";
+    for (const MetricsSnapshot::Entry& entry : entries) {
+        const MetricsSnapshot::Histogram& histogram = entry.prepare_latency;
+        const std::string label = kind + "=\"" + escape(entry.name) + "\"";
+        long cumulative = 0;
+        for (size_t i = 0; i < histogram.counts.size(); ++i) {
+            cumulative += histogram.counts[i];
+            out << prefix << "prepare_latency_seconds_bucket{" << label << ",le=\"";
+            if (i < histogram.upper_bounds_ns.size()) {
+                out << histogram.upper_bounds_ns[i] / 1e9;
+            } else {
+                out << "+Inf";
+            }
+            out << "\"} " << cumulative << "\n";
+        }
+        out << prefix << "prepare_latency_seconds_sum{" << label << "} " << histogram.sum_ns / 1e9 << "\n";
+        out << prefix << "prepare_latency_seconds_count{" << label << "} " << histogram.count << "\n";
+    }
+}
+
+} // namespace
+
+// Exports the snapshot as a JSON object
+std::string MetricsSnapshot::toJson() const {
+    std::ostringstream out;
+    out << "{\n  \"queue_high_water\": " << queue_high_water << ",\n  \"stations\": ";
+    writeEntriesJson(out, stations);
+    out << ",\n  \"dishes\": ";
+    writeEntriesJson(out, dishes);
+    out << "\n}\n";
+    return out.str();
+}
+
+// Exports the snapshot in the Prometheus text exposition format
+std::string MetricsSnapshot::toPrometheus() const {
+    std::ostringstream out;
+    out.precision(10); // Keep every bucket bound exact
+    out << "# TYPE vb_queue_high_water gauge\nvb_queue_high_water " << queue_high_water << "\n";
+    writeEntriesPrometheus(out, stations, "station");
+    writeEntriesPrometheus(out, dishes, "dish");
+    return out.str();
+}
+
+// Writes the JSON export to a file
+bool MetricsSnapshot::writeJson(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+    file << toJson();
+    return static_cast<bool>(file);
+}
+
+// Default Constructor
+MetricsRegistry::MetricsRegistry() : queue_high_water_(0) {
+}
+
+// Copies every counter of a map that has recorded anything into snapshot entries sorted by name
+std::vector<MetricsSnapshot::Entry> MetricsRegistry::collect(const CounterMap& map) {
+    std::vector<MetricsSnapshot::Entry> entries;
+    entries.reserve(map.size());
+    for (const auto& item : map) {
+        const Counters& counters = *item.second;
+        // Handles are resolved ahead of use, and reset() only zeroes entries
+        if (counters.attempted.load(std::memory_order_relaxed) == 0 && counters.replenishments.load(std::memory_order_relaxed) == 0
+            && counters.backup_misses.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        MetricsSnapshot::Entry entry;
+        entry.name = item.first;
+        entry.attempted = counters.attempted.load(std::memory_order_relaxed);
+        entry.prepared = counters.prepared.load(std::memory_order_relaxed);
+        entry.failed = counters.failed.load(std::memory_order_relaxed);
+        entry.replenishments = counters.replenishments.load(std::memory_order_relaxed);
+        entry.backup_misses = counters.backup_misses.load(std::memory_order_relaxed);
+        for (int i = 0; i <= LATENCY_BUCKETS; ++i) {
+            if (i < LATENCY_BUCKETS) {
+                entry.prepare_latency.upper_bounds_ns.push_back(uint64_t(256) << i);
+            }
+            long count = counters.latency_buckets[i].load(std::memory_order_relaxed);
+            entry.prepare_latency.counts.push_back(count);
+            entry.prepare_latency.count += count;
+        }
+        entry.prepare_latency.sum_ns = counters.latency_sum_ns.load(std::memory_order_relaxed);
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const MetricsSnapshot::Entry& a, const MetricsSnapshot::Entry& b) {
+        return a.name < b.name;
+    });
+    return entries;
+}
+
+// Copies every counter into a snapshot
+MetricsSnapshot MetricsRegistry::snapshot() const {
+    MetricsSnapshot snapshot;
+    std::lock_guard<std::mutex> lock(creation_mutex_);
+    snapshot.queue_high_water = queue_high_water_.load(std::memory_order_relaxed);
+    snapshot.stations = collect(stations_);
+    snapshot.dishes = collect(dishes_);
+    return snapshot;
+}
+
+// Zeroes every counter, keeping the entries so that handles stay valid
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(creation_mutex_);
+    for (CounterMap* map : {&stations_, &dishes_}) {
+        for (auto& item : *map) {
+            Counters& counters = *item.second;
+            for (std::atomic<long>* counter : {&counters.attempted, &counters.prepared, &counters.failed, &counters.replenishments, &counters.backup_misses}) {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            for (std::atomic<long>& bucket : counters.latency_buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            counters.latency_sum_ns.store(0, std::memory_order_relaxed);
+        }
+    }
+    queue_high_water_.store(0, std::memory_order_relaxed);
+}
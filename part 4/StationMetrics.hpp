@@ -0,0 +1,256 @@
+/** Header file for the MetricsRegistry class, the per-station and per-dish counters and prepare latency
+    histograms of the StationManager, and the MetricsSnapshot it exports as JSON or Prometheus text.
+    Building with -DVB_DISABLE_METRICS turns every record call into an empty inline function, and every
+    statement wrapped in VB_METRICS() into nothing. **/
+
+#ifndef STATIONMETRICS_HPP
+#define STATIONMETRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Wraps a metrics statement, arguments included, so that -DVB_DISABLE_METRICS compiles it out entirely.
+#ifndef VB_DISABLE_METRICS
+#define VB_METRICS(...) __VA_ARGS__
+#else
+#define VB_METRICS(...)
+#endif
+
+/**
+ * A point-in-time copy of the metrics, safe to keep after the StationManager is gone.
+ */
+struct MetricsSnapshot {
+    struct Histogram {
+        std::vector<uint64_t> upper_bounds_ns; ///< Inclusive upper bound of every bucket but the last (+Inf).
+        std::vector<long> counts;              ///< Observations per bucket; one more entry than upper_bounds_ns.
+        long count = 0;                        ///< Total observations.
+        uint64_t sum_ns = 0;                   ///< Sum of all observations.
+    };
+
+    struct Entry {
+        std::string name;
+        long attempted = 0;      ///< Stations: prepare attempts on a dish it carries. Dishes: servings routed.
+        long prepared = 0;       ///< Successful attempts (stations) or servings prepared (dishes).
+        long failed = 0;         ///< Failed attempts (stations) or servings left unprepared (dishes).
+        long replenishments = 0; ///< Successful replenishments from backup stock.
+        long backup_misses = 0;  ///< Replenishments the backup stock could not cover.
+        Histogram prepare_latency;
+    };
+
+    long queue_high_water = 0;  ///< Largest dish queue depth seen.
+    std::vector<Entry> stations; ///< Sorted by name.
+    std::vector<Entry> dishes;   ///< Sorted by name.
+
+    /**
+     * @return: The snapshot as a JSON object.
+     */
+    std::string toJson() const;
+
+    /**
+     * @return: The snapshot in the Prometheus text exposition format, with metric names prefixed by vb_.
+     */
+    std::string toPrometheus() const;
+
+    /**
+     * Writes toJson() to a file.
+     * @param filename The file to create or overwrite.
+     * @return: True if the file was written; false otherwise.
+     */
+    bool writeJson(const std::string& filename) const;
+};
+
+class MetricsRegistry {
+
+public:
+    /// Buckets double from 256 ns up to 8.4 ms; the last bucket counts everything slower.
+    static const int LATENCY_BUCKETS = 16;
+
+    /**
+     * Counters of one station or dish. Updated with relaxed atomics, so another thread may read them while
+     * the StationManager works. Entries are created under a mutex that snapshot() also holds.
+     */
+    struct Counters {
+        std::atomic<long> attempted{0};
+        std::atomic<long> prepared{0};
+        std::atomic<long> failed{0};
+        std::atomic<long> replenishments{0};
+        std::atomic<long> backup_misses{0};
+        std::atomic<long> latency_buckets[LATENCY_BUCKETS + 1] = {};
+        std::atomic<uint64_t> latency_sum_ns{0};
+    };
+
+    MetricsRegistry();
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @return: A timestamp in nanoseconds for measuring prepare latency, or 0 when metrics are compiled out.
+     */
+    static uint64_t now();
+
+    /**
+     * @return: The counters of a station, created if it has none yet. The handle stays valid for the lifetime
+     * of the registry (reset() zeroes counters in place), so callers resolve it once and record through it.
+     * nullptr when metrics are compiled out.
+     */
+    Counters* stationCounters(const std::string& station);
+
+    /**
+     * @return: The counters of a dish, created if it has none yet; see stationCounters.
+     */
+    Counters* dishCounters(const std::string& dish);
+
+    /**
+     * Records one station's attempt to prepare a dish it carries.
+     * @param station The station's counters.
+     * @param prepared Whether the attempt succeeded.
+     * @param latency_ns How long the attempt took.
+     */
+    void recordStationAttempt(Counters* station, bool prepared, uint64_t latency_ns);
+
+    /**
+     * Records the outcome of routing servings of a dish.
+     * @param dish The dish's counters.
+     * @param servings The number of servings routed together.
+     * @param prepared Whether they were prepared.
+     * @param latency_ns How long routing took, from the first probe to the outcome.
+     */
+    void recordDish(Counters* dish, long servings, bool prepared, uint64_t latency_ns);
+
+    /**
+     * Records a replenishment from backup stock for a station and, if not nullptr, the dish that needed it.
+     */
+    void recordReplenishment(Counters* station, Counters* dish);
+
+    /**
+     * Records a replenishment that the backup stock could not cover.
+     */
+    void recordBackupMiss(Counters* station, Counters* dish);
+
+    /**
+     * Raises the queue high-water mark to depth if it is larger.
+     */
+    void observeQueueDepth(size_t depth);
+
+    /**
+     * @return: A copy of every counter that has recorded anything, stations and dishes sorted by name. Safe to call from any thread while
+     * the record calls run.
+     */
+    MetricsSnapshot snapshot() const;
+
+    /**
+     * Zeroes every counter and the queue high-water mark. Entries are kept, so resolved handles stay valid.
+     * @pre: No record call runs at the same time.
+     */
+    void reset();
+
+private:
+    using CounterMap = std::unordered_map<std::string, std::unique_ptr<Counters>>;
+
+    Counters& lookup(CounterMap& map, const std::string& name);
+    static void observe(Counters& counters, uint64_t latency_ns);
+    static std::vector<MetricsSnapshot::Entry> collect(const CounterMap& map);
+
+    /// Held while an entry is created and while the maps are walked or zeroed. Handles are resolved on the
+    /// recording thread, so their lookups only read the maps there and need not hold it.
+    mutable std::mutex creation_mutex_;
+    CounterMap stations_;
+    CounterMap dishes_;
+    std::atomic<long> queue_high_water_;
+};
+
+#ifndef VB_DISABLE_METRICS
+
+inline uint64_t MetricsRegistry::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline MetricsRegistry::Counters& MetricsRegistry::lookup(CounterMap& map, const std::string& name) {
+    auto found = map.find(name);
+    if (found == map.end()) {
+        std::lock_guard<std::mutex> lock(creation_mutex_);
+        found = map.emplace(name, std::unique_ptr<Counters>(new Counters())).first;
+    }
+    return *found->second;
+}
+
+inline MetricsRegistry::Counters* MetricsRegistry::stationCounters(const std::string& station) {
+    return &lookup(stations_, station);
+}
+
+inline MetricsRegistry::Counters* MetricsRegistry::dishCounters(const std::string& dish) {
+    return &lookup(dishes_, dish);
+}
+
+inline void MetricsRegistry::observe(Counters& counters, uint64_t latency_ns) {
+    // Bucket i holds latencies up to 256 << i ns
+    int bucket = latency_ns <= 256 ? 0 : 64 - __builtin_clzll((latency_ns - 1) >> 8);
+    if (bucket > LATENCY_BUCKETS) {
+        bucket = LATENCY_BUCKETS;
+    }
+    counters.latency_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    counters.latency_sum_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+}
+
+inline void MetricsRegistry::recordStationAttempt(Counters* station, bool prepared, uint64_t latency_ns) {
+    station->attempted.fetch_add(1, std::memory_order_relaxed);
+    if (prepared) {
+        station->prepared.fetch_add(1, std::memory_order_relaxed);
+        observe(*station, latency_ns);
+    } else {
+        station->failed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void MetricsRegistry::recordDish(Counters* dish, long servings, bool prepared, uint64_t latency_ns) {
+    dish->attempted.fetch_add(servings, std::memory_order_relaxed);
+    if (prepared) {
+        dish->prepared.fetch_add(servings, std::memory_order_relaxed);
+        observe(*dish, latency_ns);
+    } else {
+        dish->failed.fetch_add(servings, std::memory_order_relaxed);
+    }
+}
+
+inline void MetricsRegistry::recordReplenishment(Counters* station, Counters* dish) {
+    station->replenishments.fetch_add(1, std::memory_order_relaxed);
+    if (dish) {
+        dish->replenishments.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void MetricsRegistry::recordBackupMiss(Counters* station, Counters* dish) {
+    station->backup_misses.fetch_add(1, std::memory_order_relaxed);
+    if (dish) {
+        dish->backup_misses.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void MetricsRegistry::observeQueueDepth(size_t depth) {
+    long value = static_cast<long>(depth);
+    if (value > queue_high_water_.load(std::memory_order_relaxed)) {
+        queue_high_water_.store(value, std::memory_order_relaxed);
+    }
+}
+
+#else
+
+inline uint64_t MetricsRegistry::now() { return 0; }
+inline MetricsRegistry::Counters* MetricsRegistry::stationCounters(const std::string&) { return nullptr; }
+inline MetricsRegistry::Counters* MetricsRegistry::dishCounters(const std::string&) { return nullptr; }
+inline void MetricsRegistry::recordStationAttempt(Counters*, bool, uint64_t) {}
+inline void MetricsRegistry::recordDish(Counters*, long, bool, uint64_t) {}
+inline void MetricsRegistry::recordReplenishment(Counters*, Counters*) {}
+inline void MetricsRegistry::recordBackupMiss(Counters*, Counters*) {}
+inline void MetricsRegistry::observeQueueDepth(size_t) {}
+
+#endif
+
+#endif
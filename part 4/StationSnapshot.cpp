@@ -0,0 +1,400 @@
+// StationSnapshot.cpp contains the encoder and the memory-mapped reader of the StationManager snapshot format.
+#include "StationSnapshot.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "PlainDish.hpp"
+#include "StationManager.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[8] = {'V', 'B', 'S', 'N', 'A', 'P', '\0', '\0'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+static_assert(std::is_trivially_copyable<SnapshotHeader>::value, "snapshot records are copied as bytes");
+static_assert(sizeof(SnapshotIngredient) % 8 == 0 && sizeof(SnapshotDish) % 8 == 0 &&
+              sizeof(SnapshotStation) % 8 == 0 && sizeof(SnapshotSideDish) % 8 == 0 && sizeof(SnapshotHeader) % 8 == 0,
+              "snapshot records keep 8-byte alignment");
+
+uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+template <typename Record>
+void appendSection(std::string& image, uint64_t offset, const std::vector<Record>& records) {
+    image.resize(offset);
+    if (!records.empty()) {
+        image.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    }
+}
+
+// True if [first, first + count) lies inside an array of size records
+bool validRange(uint64_t first, uint64_t count, uint64_t size) {
+    return first <= size && count <= size - first;
+}
+
+// True if style is a value of the enum the dish kind stores in it; a PlainDish has none
+bool validStyle(uint8_t kind, uint8_t style) {
+    switch (kind) {
+        case SnapshotDish::APPETIZER: return style <= Appetizer::BUFFET;
+        case SnapshotDish::MAIN_COURSE: return style <= MainCourse::RAW;
+        case SnapshotDish::DESSERT: return style <= Dessert::UMAMI;
+        default: return style == 0;
+    }
+}
+
+} // namespace
+
+// Returns the CuisineType whose name Dish::getCuisineType() returns
+Dish::CuisineType cuisineFromName(const std::string& name) {
+    static const char* names[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH"};
+    for (int i = 0; i < 6; ++i) {
+        if (name == names[i]) {
+            return static_cast<Dish::CuisineType>(i);
+        }
+    }
+    return Dish::OTHER;
+}
+
+// Default Constructor
+SnapshotBuilder::SnapshotBuilder() : header_(), queue_started_(false), backup_started_(false) {
+    std::memcpy(header_.magic, MAGIC, sizeof(MAGIC));
+    header_.version = VERSION;
+    header_.byte_order = BYTE_ORDER_MARK;
+    header_.hit_decay = 1.0;
+}
+
+SnapshotString SnapshotBuilder::addString(const std::string& text) {
+    SnapshotString reference = {static_cast<uint32_t>(strings_.size()), static_cast<uint32_t>(text.size())};
+    strings_ += text;
+    return reference;
+}
+
+SnapshotIngredient SnapshotBuilder::encodeIngredient(const Ingredient& ingredient) {
+    SnapshotIngredient record;
+    record.name = addString(ingredient.name);
+    record.quantity = ingredient.quantity;
+    record.required_quantity = ingredient.required_quantity;
+    record.price = ingredient.price;
+    return record;
+}
+
+// Encodes one dish, appending its ingredients and side dishes to the shared arrays
+void SnapshotBuilder::encodeDish(const Dish& dish, SnapshotDish& record) {
+    record = SnapshotDish();
+    if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(&dish)) {
+        record.kind = SnapshotDish::APPETIZER;
+        record.style = static_cast<uint8_t>(appetizer->getServingStyle());
+        record.level = appetizer->getSpicinessLevel();
+        record.flag = appetizer->isVegetarian();
+    } else if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(&dish)) {
+        record.kind = SnapshotDish::MAIN_COURSE;
+        record.style = static_cast<uint8_t>(main_course->getCookingMethod());
+        record.flag = main_course->isGlutenFree();
+        record.protein_type = addString(main_course->getProteinType());
+        std::vector<MainCourse::SideDish> sides = main_course->getSideDishes();
+        record.first_side_dish = static_cast<uint32_t>(side_dishes_.size());
+        record.side_dish_count = static_cast<uint32_t>(sides.size());
+        for (const MainCourse::SideDish& side : sides) {
+            side_dishes_.push_back({addString(side.name), static_cast<int32_t>(side.category), 0});
+        }
+    } else if (const Dessert* dessert = dynamic_cast<const Dessert*>(&dish)) {
+        record.kind = SnapshotDish::DESSERT;
+        record.style = static_cast<uint8_t>(dessert->getFlavorProfile());
+        record.level = dessert->getSweetnessLevel();
+        record.flag = dessert->containsNuts();
+    } else {
+        record.kind = SnapshotDish::PLAIN; // Only the Dish fields below are kept
+    }
+
+    record.name = addString(dish.getName());
+    record.prep_time = dish.getPrepTime();
+    record.price = dish.getPrice();
+    record.cuisine_type = static_cast<uint8_t>(cuisineFromName(dish.getCuisineType()));
+    std::vector<Ingredient> ingredients = dish.getIngredients();
+    record.first_ingredient = static_cast<uint32_t>(ingredients_.size());
+    record.ingredient_count = static_cast<uint32_t>(ingredients.size());
+    for (const Ingredient& ingredient : ingredients) {
+        ingredients_.push_back(encodeIngredient(ingredient));
+    }
+}
+
+// Appends a station with its dishes and stock
+bool SnapshotBuilder::addStation(const KitchenStation& station) {
+    if (queue_started_ || backup_started_) {
+        return false;
+    }
+    SnapshotStation record;
+    record.name = addString(station.getName());
+    record.first_dish = static_cast<uint32_t>(dishes_.size());
+    std::vector<Dish*> dishes = station.getDishes();
+    for (const Dish* dish : dishes) {
+        SnapshotDish dish_record;
+        encodeDish(*dish, dish_record);
+        dishes_.push_back(dish_record);
+    }
+    record.dish_count = static_cast<uint32_t>(dishes.size());
+
+    std::vector<Ingredient> stock = station.getIngredientsStock();
+    record.first_stock = static_cast<uint32_t>(ingredients_.size());
+    record.stock_count = static_cast<uint32_t>(stock.size());
+    for (const Ingredient& ingredient : stock) {
+        ingredients_.push_back(encodeIngredient(ingredient));
+    }
+    stations_.push_back(record);
+    return true;
+}
+
+// Appends a queued dish
+bool SnapshotBuilder::addQueuedDish(const Dish& dish) {
+    if (backup_started_) {
+        return false;
+    }
+    if (!queue_started_) {
+        queue_started_ = true;
+        header_.queue_first = static_cast<uint32_t>(dishes_.size());
+    }
+    SnapshotDish record;
+    encodeDish(dish, record);
+    dishes_.push_back(record);
+    header_.queue_count++;
+    return true;
+}
+
+// Appends a backup ingredient
+void SnapshotBuilder::addBackupIngredient(const Ingredient& ingredient) {
+    if (!backup_started_) {
+        backup_started_ = true;
+        header_.backup_first = static_cast<uint32_t>(ingredients_.size());
+    }
+    ingredients_.push_back(encodeIngredient(ingredient));
+    header_.backup_count++;
+}
+
+// Lays out the header, the record arrays and the string blob
+std::string SnapshotBuilder::image() {
+    if (!queue_started_) {
+        header_.queue_first = static_cast<uint32_t>(dishes_.size());
+    }
+    if (!backup_started_) {
+        header_.backup_first = static_cast<uint32_t>(ingredients_.size());
+    }
+    header_.station_count = static_cast<uint32_t>(stations_.size());
+    header_.dish_count = static_cast<uint32_t>(dishes_.size());
+    header_.ingredient_count = static_cast<uint32_t>(ingredients_.size());
+    header_.side_dish_count = static_cast<uint32_t>(side_dishes_.size());
+    header_.stations_offset = sizeof(SnapshotHeader);
+    header_.dishes_offset = align8(header_.stations_offset + stations_.size() * sizeof(SnapshotStation));
+    header_.ingredients_offset = align8(header_.dishes_offset + dishes_.size() * sizeof(SnapshotDish));
+    header_.side_dishes_offset = align8(header_.ingredients_offset + ingredients_.size() * sizeof(SnapshotIngredient));
+    header_.strings_offset = align8(header_.side_dishes_offset + side_dishes_.size() * sizeof(SnapshotSideDish));
+    header_.strings_size = strings_.size();
+    header_.file_size = header_.strings_offset + strings_.size();
+
+    std::string image;
+    image.reserve(header_.file_size);
+    image.append(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    appendSection(image, header_.stations_offset, stations_);
+    appendSection(image, header_.dishes_offset, dishes_);
+    appendSection(image, header_.ingredients_offset, ingredients_);
+    appendSection(image, header_.side_dishes_offset, side_dishes_);
+    image.resize(header_.strings_offset);
+    image += strings_;
+    return image;
+}
+
+// Writes the snapshot to a temporary file and renames it over filename
+bool SnapshotBuilder::write(const std::string& filename) {
+    std::string bytes = image();
+    std::string temporary = filename + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    written = std::fflush(file) == 0 && written;
+    written = fsync(fileno(file)) == 0 && written;
+    written = std::fclose(file) == 0 && written;
+    if (!written || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Default Constructor
+SnapshotImage::SnapshotImage()
+    : data_(nullptr), size_(0), mapping_(nullptr), header_(nullptr), stations_(nullptr), dishes_(nullptr),
+      ingredients_(nullptr), side_dishes_(nullptr), strings_(nullptr) {
+}
+
+SnapshotImage::~SnapshotImage() {
+    unmap();
+}
+
+void SnapshotImage::unmap() {
+    if (mapping_) {
+        munmap(mapping_, size_);
+        mapping_ = nullptr;
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+// Maps a snapshot file read-only and validates it
+bool SnapshotImage::open(const std::string& filename) {
+    unmap();
+    int descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        close(descriptor);
+        return false;
+    }
+    void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = mapping;
+    data_ = static_cast<const char*>(mapping);
+    size_ = static_cast<size_t>(status.st_size);
+    if (!validate()) {
+        unmap();
+        return false;
+    }
+    return true;
+}
+
+// Validates an image already in memory
+bool SnapshotImage::openBuffer(const char* data, size_t size) {
+    unmap();
+    if (data == nullptr || size < sizeof(SnapshotHeader) || reinterpret_cast<uintptr_t>(data) % 8 != 0) {
+        return false;
+    }
+    data_ = data;
+    size_ = size;
+    if (!validate()) {
+        data_ = nullptr;
+        size_ = 0;
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotImage::validString(const SnapshotString& text) const {
+    return validRange(text.offset, text.length, header_->strings_size);
+}
+
+// Checks the header, every section, range, string and enum value, so makeDish can trust the records
+bool SnapshotImage::validate() {
+    header_ = reinterpret_cast<const SnapshotHeader*>(data_);
+    const SnapshotHeader& header = *header_;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != SnapshotBuilder::VERSION ||
+        header.byte_order != BYTE_ORDER_MARK || header.file_size != size_) {
+        return false;
+    }
+    if (header.plan_objective > ReplenishmentPlanner::MAXIMIZE_VALUE || header.station_ordering > StationManager::FREQUENCY_COUNT ||
+        header.station_routing > StationManager::LEAST_BUSY) {
+        return false;
+    }
+
+    const struct {
+        uint64_t offset;
+        uint64_t bytes;
+    } sections[] = {
+        {header.stations_offset, uint64_t(header.station_count) * sizeof(SnapshotStation)},
+        {header.dishes_offset, uint64_t(header.dish_count) * sizeof(SnapshotDish)},
+        {header.ingredients_offset, uint64_t(header.ingredient_count) * sizeof(SnapshotIngredient)},
+        {header.side_dishes_offset, uint64_t(header.side_dish_count) * sizeof(SnapshotSideDish)},
+        {header.strings_offset, header.strings_size},
+    };
+    for (const auto& section : sections) {
+        if (section.offset % 8 != 0 || section.offset < sizeof(SnapshotHeader) || !validRange(section.offset, section.bytes, size_)) {
+            return false;
+        }
+    }
+    stations_ = reinterpret_cast<const SnapshotStation*>(data_ + header.stations_offset);
+    dishes_ = reinterpret_cast<const SnapshotDish*>(data_ + header.dishes_offset);
+    ingredients_ = reinterpret_cast<const SnapshotIngredient*>(data_ + header.ingredients_offset);
+    side_dishes_ = reinterpret_cast<const SnapshotSideDish*>(data_ + header.side_dishes_offset);
+    strings_ = data_ + header.strings_offset;
+
+    if (!validRange(header.queue_first, header.queue_count, header.dish_count) ||
+        !validRange(header.backup_first, header.backup_count, header.ingredient_count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header.ingredient_count; ++i) {
+        if (!validString(ingredients_[i].name)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.side_dish_count; ++i) {
+        if (!validString(side_dishes_[i].name) || side_dishes_[i].category < MainCourse::GRAIN ||
+            side_dishes_[i].category > MainCourse::VEGETABLE) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.dish_count; ++i) {
+        const SnapshotDish& dish = dishes_[i];
+        if (dish.kind < SnapshotDish::APPETIZER || dish.kind > SnapshotDish::PLAIN || !validStyle(dish.kind, dish.style) ||
+            dish.cuisine_type > Dish::OTHER || !validString(dish.name) ||
+            !validString(dish.protein_type) || !validRange(dish.first_ingredient, dish.ingredient_count, header.ingredient_count) ||
+            !validRange(dish.first_side_dish, dish.side_dish_count, header.side_dish_count)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.station_count; ++i) {
+        const SnapshotStation& station = stations_[i];
+        if (!validString(station.name) || !validRange(station.first_dish, station.dish_count, header.dish_count) ||
+            !validRange(station.first_stock, station.stock_count, header.ingredient_count)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Ingredient SnapshotImage::makeIngredient(const SnapshotIngredient& record) const {
+    return Ingredient(std::string(str(record.name)), record.quantity, record.required_quantity, record.price);
+}
+
+// Builds a new Appetizer, MainCourse, Dessert or PlainDish from a dish record
+Dish* SnapshotImage::makeDish(const SnapshotDish& record) const {
+    std::vector<Ingredient> ingredients;
+    ingredients.reserve(record.ingredient_count);
+    for (uint32_t i = 0; i < record.ingredient_count; ++i) {
+        ingredients.push_back(makeIngredient(ingredients_[record.first_ingredient + i]));
+    }
+    std::string name(str(record.name));
+    Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(record.cuisine_type);
+
+    switch (record.kind) {
+        case SnapshotDish::APPETIZER:
+            return new Appetizer(name, ingredients, record.prep_time, record.price, cuisine,
+                                 static_cast<Appetizer::ServingStyle>(record.style), record.level, record.flag != 0);
+        case SnapshotDish::MAIN_COURSE: {
+            std::vector<MainCourse::SideDish> sides;
+            for (uint32_t i = 0; i < record.side_dish_count; ++i) {
+                const SnapshotSideDish& side = side_dishes_[record.first_side_dish + i];
+                sides.push_back({std::string(str(side.name)), static_cast<MainCourse::Category>(side.category)});
+            }
+            return new MainCourse(name, ingredients, record.prep_time, record.price, cuisine,
+                                  static_cast<MainCourse::CookingMethod>(record.style), std::string(str(record.protein_type)),
+                                  sides, record.flag != 0);
+        }
+        case SnapshotDish::PLAIN:
+            return new PlainDish(name, ingredients, record.prep_time, record.price, cuisine);
+        default:
+            return new Dessert(name, ingredients, record.prep_time, record.price, cuisine,
+                               static_cast<Dessert::FlavorProfile>(record.style), record.level, record.flag != 0);
+    }
+}
@@ -0,0 +1,202 @@
+/** Header file for the StationManager snapshot format. A snapshot is one file: a fixed header followed by
+    arrays of fixed-size, 8-byte aligned records and a string blob, so it can be mapped into memory and read
+    in place. Records refer to each other by index ranges and to names by offset and length into the blob.
+    SnapshotBuilder writes the format; SnapshotImage maps a file, validates it and rebuilds dishes from it. **/
+
+#ifndef STATIONSNAPSHOT_HPP
+#define STATIONSNAPSHOT_HPP
+
+#include "Dish.hpp"
+#include "KitchenStation.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct SnapshotString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct SnapshotIngredient {
+    SnapshotString name;
+    int32_t quantity;
+    int32_t required_quantity;
+    double price;
+};
+
+struct SnapshotSideDish {
+    SnapshotString name;
+    int32_t category;
+    int32_t reserved;
+};
+
+struct SnapshotDish {
+    /** PLAIN: any other Dish, of which only the Dish fields are kept; it is restored as a PlainDish */
+    enum Kind : uint8_t { APPETIZER = 1, MAIN_COURSE = 2, DESSERT = 3, PLAIN = 4 };
+
+    SnapshotString name;
+    SnapshotString protein_type;  ///< Main courses only
+    uint32_t first_ingredient;
+    uint32_t ingredient_count;
+    uint32_t first_side_dish;     ///< Main courses only
+    uint32_t side_dish_count;
+    int32_t prep_time;
+    int32_t level;                ///< Spiciness (appetizers) or sweetness (desserts)
+    double price;
+    uint8_t kind;
+    uint8_t cuisine_type;
+    uint8_t style;                ///< Serving style, cooking method or flavor profile
+    uint8_t flag;                 ///< Vegetarian, gluten-free or contains nuts
+    uint32_t reserved;
+};
+
+struct SnapshotStation {
+    SnapshotString name;
+    uint32_t first_dish;
+    uint32_t dish_count;
+    uint32_t first_stock;
+    uint32_t stock_count;
+};
+
+struct SnapshotHeader {
+    char magic[8];                ///< "VBSNAP\0\0"
+    uint32_t version;
+    uint32_t byte_order;          ///< 0x01020304 as written; restore rejects other byte orders
+    uint64_t file_size;
+    uint32_t station_count;
+    uint32_t dish_count;
+    uint32_t ingredient_count;
+    uint32_t side_dish_count;
+    uint64_t stations_offset;
+    uint64_t dishes_offset;
+    uint64_t ingredients_offset;
+    uint64_t side_dishes_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint32_t queue_first;         ///< The queued dishes are dishes [queue_first, queue_first + queue_count)
+    uint32_t queue_count;
+    uint32_t backup_first;        ///< The backup stock is ingredients [backup_first, backup_first + backup_count)
+    uint32_t backup_count;
+    uint8_t batch_cooking;
+    uint8_t replenishment_planning;
+    uint8_t plan_objective;
+    uint8_t station_ordering;
+    uint8_t station_routing;
+    uint8_t reserved[3];
+    double hit_decay;
+    uint64_t wal_sequence;        ///< The last WriteAheadLog record the snapshot includes
+};
+
+class SnapshotBuilder {
+
+public:
+    static const uint32_t VERSION = 2;
+
+    SnapshotBuilder();
+
+    /**
+     * Appends a station with its dishes and stock.
+     * @return: False if a queued dish or backup ingredient was already added.
+     */
+    bool addStation(const KitchenStation& station);
+
+    /**
+     * Appends a queued dish; queued dishes must be added after every station.
+     * @return: False if a backup ingredient was already added.
+     */
+    bool addQueuedDish(const Dish& dish);
+
+    /**
+     * Appends a backup ingredient; backup ingredients must be added after every station and queued dish.
+     */
+    void addBackupIngredient(const Ingredient& ingredient);
+
+    /**
+     * @return: The header fields holding the StationManager settings, to be filled in before write().
+     */
+    SnapshotHeader& settings() { return header_; }
+
+    /**
+     * @return: The encoded snapshot.
+     */
+    std::string image();
+
+    /**
+     * Writes the snapshot to a temporary file and renames it over filename, so a crash never leaves a
+     * half-written snapshot behind.
+     * @return: True if the snapshot was written; false otherwise.
+     */
+    bool write(const std::string& filename);
+
+private:
+    void encodeDish(const Dish& dish, SnapshotDish& record);
+    SnapshotIngredient encodeIngredient(const Ingredient& ingredient);
+    SnapshotString addString(const std::string& text);
+
+    SnapshotHeader header_;
+    std::vector<SnapshotStation> stations_;
+    std::vector<SnapshotDish> dishes_;
+    std::vector<SnapshotIngredient> ingredients_;
+    std::vector<SnapshotSideDish> side_dishes_;
+    std::string strings_;
+    bool queue_started_;
+    bool backup_started_;
+};
+
+class SnapshotImage {
+
+public:
+    SnapshotImage();
+    ~SnapshotImage();
+    SnapshotImage(const SnapshotImage&) = delete;
+    SnapshotImage& operator=(const SnapshotImage&) = delete;
+
+    /**
+     * Maps a snapshot file read-only and validates the header, every range, every string and every enum value.
+     * @return: True if the file is a valid snapshot of SnapshotBuilder::VERSION; false otherwise.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * Validates an image already in memory; the buffer must stay alive and 8-byte aligned while in use.
+     */
+    bool openBuffer(const char* data, size_t size);
+
+    const SnapshotHeader& header() const { return *header_; }
+
+    const SnapshotStation* stations() const { return stations_; }
+    const SnapshotDish* dishes() const { return dishes_; }
+    const SnapshotIngredient* ingredients() const { return ingredients_; }
+
+    std::string_view str(const SnapshotString& text) const { return std::string_view(strings_ + text.offset, text.length); }
+
+    Ingredient makeIngredient(const SnapshotIngredient& record) const;
+
+    /**
+     * @return: A new Appetizer, MainCourse, Dessert or PlainDish built from a dish record; the caller owns it.
+     */
+    Dish* makeDish(const SnapshotDish& record) const;
+
+private:
+    bool validate();
+    bool validString(const SnapshotString& text) const;
+    void unmap();
+
+    const char* data_;
+    size_t size_;
+    void* mapping_;
+    const SnapshotHeader* header_;
+    const SnapshotStation* stations_;
+    const SnapshotDish* dishes_;
+    const SnapshotIngredient* ingredients_;
+    const SnapshotSideDish* side_dishes_;
+    const char* strings_;
+};
+
+/**
+ * @return: The CuisineType whose name Dish::getCuisineType() returns.
+ */
+Dish::CuisineType cuisineFromName(const std::string& name);
+
+#endif
@@ -0,0 +1,370 @@
+/** ADT list: Unrolled linked list implementation.
+
+ Implementation file for the class UnrolledList.
+ @file UnrolledList.cpp */
+
+#include "UnrolledList.hpp"  // Header file
+#include <string>
+#include <utility>
+
+// constructor
+template<class T, int Capacity>
+UnrolledList<T, Capacity>::UnrolledList() : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0)
+{
+}  // end default constructor
+
+
+// copy constructor
+template<class T, int Capacity>
+UnrolledList<T, Capacity>::UnrolledList(const UnrolledList<T, Capacity>& a_list)
+   : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(a_list.item_count_)
+{
+   // Copy block by block, keeping the same fill
+   for (Block* orig_ptr = a_list.head_ptr_; orig_ptr != nullptr; orig_ptr = orig_ptr->next_)
+   {
+      Block* new_block_ptr = new Block();
+      for (int i = 0; i < orig_ptr->count_; i++)
+         new_block_ptr->items_[i] = orig_ptr->items_[i];
+      new_block_ptr->count_ = orig_ptr->count_;
+
+      if (tail_ptr_ == nullptr)
+         head_ptr_ = new_block_ptr;
+      else
+         tail_ptr_->next_ = new_block_ptr;
+      tail_ptr_ = new_block_ptr;
+   }  // end for
+}  // end copy constructor
+
+
+// copy-and-swap assignment
+template<class T, int Capacity>
+UnrolledList<T, Capacity>& UnrolledList<T, Capacity>::operator=(UnrolledList<T, Capacity> a_list)
+{
+   std::swap(head_ptr_, a_list.head_ptr_);
+   std::swap(tail_ptr_, a_list.tail_ptr_);
+   std::swap(item_count_, a_list.item_count_);
+   return *this;
+}  // end operator=
+
+
+// destructor
+template<class T, int Capacity>
+UnrolledList<T, Capacity>::~UnrolledList()
+{
+   clear();
+}  // end destructor
+
+
+/**@return true if list is empty - item_count_ == 0 */
+template<class T, int Capacity>
+bool UnrolledList<T, Capacity>::isEmpty() const
+{
+   return item_count_ == 0;
+}  // end isEmpty
+
+
+/**@return the number of items in the list - item_count_ */
+template<class T, int Capacity>
+int UnrolledList<T, Capacity>::getLength() const
+{
+   return item_count_;
+}  // end getLength
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param new_entry to be inserted in list
+ @post new_entry is added at position in list (the entry previously at that position is now at position+1).
+       A full block is split in two
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T, int Capacity>
+bool UnrolledList<T, Capacity>::insert(int position, const T& new_entry)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_);
+   if (able_to_insert)
+   {
+      int index = 0;
+      Block* block_ptr = getBlockAt(position, index);
+      if (block_ptr == nullptr)
+      {
+         // First entry of an empty list
+         block_ptr = new Block();
+         head_ptr_ = block_ptr;
+         tail_ptr_ = block_ptr;
+      }
+      else if (block_ptr->count_ == Capacity && index == Capacity)
+      {
+         // Appending past a full block starts a new one, so a list built in order stays full
+         Block* new_block_ptr = new Block();
+         new_block_ptr->next_ = block_ptr->next_;
+         block_ptr->next_ = new_block_ptr;
+         if (tail_ptr_ == block_ptr)
+            tail_ptr_ = new_block_ptr;
+         block_ptr = new_block_ptr;
+         index = 0;
+      }
+      else if (block_ptr->count_ == Capacity)
+      {
+         // Split the full block and insert into the half that holds the position
+         Block* upper_ptr = splitBlock(block_ptr);
+         if (index > block_ptr->count_)
+         {
+            index -= block_ptr->count_;
+            block_ptr = upper_ptr;
+         }  // end if
+      }  // end if
+
+      // Shift the later entries of the block up by one
+      for (int i = block_ptr->count_; i > index; i--)
+         block_ptr->items_[i] = std::move(block_ptr->items_[i - 1]);
+      block_ptr->items_[index] = new_entry;
+      block_ptr->count_++;
+      item_count_++;
+   }  // end if
+
+   return able_to_insert;
+}  // end insert
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is the last entry of the list; O(1) through tail_ptr_ */
+template<class T, int Capacity>
+void UnrolledList<T, Capacity>::push_back(const T& new_entry)
+{
+   insert(item_count_, new_entry);
+}  // end push_back
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is the first entry of the list */
+template<class T, int Capacity>
+void UnrolledList<T, Capacity>::push_front(const T& new_entry)
+{
+   insert(0, new_entry);
+}  // end push_front
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of deletion
+ @post entry at position is deleted, if any. List order is retained. An emptied block is freed,
+       and a block less than a quarter full takes in its successor when both fit in one block
+ @return true if there is an entry at position to be deleted, false otherwise */
+template<class T, int Capacity>
+bool UnrolledList<T, Capacity>::remove(int position)
+{
+   bool able_to_remove = (position >= 0) && (position < item_count_);
+   if (able_to_remove)
+   {
+      // Find the block and the one before it, which is needed if the block empties
+      Block* prev_ptr = nullptr;
+      Block* block_ptr = head_ptr_;
+      int index = position;
+      while (index >= block_ptr->count_)
+      {
+         index -= block_ptr->count_;
+         prev_ptr = block_ptr;
+         block_ptr = block_ptr->next_;
+      }  // end while
+
+      // Shift the later entries of the block down by one
+      for (int i = index; i < block_ptr->count_ - 1; i++)
+         block_ptr->items_[i] = std::move(block_ptr->items_[i + 1]);
+      block_ptr->items_[block_ptr->count_ - 1] = T();
+      block_ptr->count_--;
+      item_count_--;
+
+      if (block_ptr->count_ == 0)
+      {
+         // Unlink and free the empty block
+         if (prev_ptr == nullptr)
+            head_ptr_ = block_ptr->next_;
+         else
+            prev_ptr->next_ = block_ptr->next_;
+         if (tail_ptr_ == block_ptr)
+            tail_ptr_ = prev_ptr;
+         delete block_ptr;
+      }
+      else if (block_ptr->count_ < Capacity / 4 && block_ptr->next_ != nullptr &&
+               block_ptr->count_ + block_ptr->next_->count_ <= Capacity)
+      {
+         // Take in the next block so sparse blocks do not pile up
+         Block* next_ptr = block_ptr->next_;
+         for (int i = 0; i < next_ptr->count_; i++)
+            block_ptr->items_[block_ptr->count_ + i] = std::move(next_ptr->items_[i]);
+         block_ptr->count_ += next_ptr->count_;
+         block_ptr->next_ = next_ptr->next_;
+         if (tail_ptr_ == next_ptr)
+            tail_ptr_ = block_ptr;
+         delete next_ptr;
+      }  // end if
+   }  // end if
+
+   return able_to_remove;
+}  // end remove
+
+
+/**@post the list is empty and item_count_ == 0*/
+template<class T, int Capacity>
+void UnrolledList<T, Capacity>::clear()
+{
+   Block* block_ptr = head_ptr_;
+   while (block_ptr != nullptr)
+   {
+      Block* next_ptr = block_ptr->next_;
+      delete block_ptr;
+      block_ptr = next_ptr;
+   }  // end while
+
+   head_ptr_ = nullptr;
+   tail_ptr_ = nullptr;
+   item_count_ = 0;
+}  // end clear
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating the position of the data to be retrieved
+ @return data item found at position. If position is not a valid position < item_count_
+ throws  PrecondViolatedExcep */
+template<class T, int Capacity>
+T UnrolledList<T, Capacity>::getEntry(int position) const
+{
+   // Enforce precondition
+   bool ableToGet = (position >= 0) && (position < item_count_);
+   if (ableToGet)
+   {
+      int index = 0;
+      Block* block_ptr = getBlockAt(position, index);
+      return block_ptr->items_[index];
+   }
+   else
+   {
+      std::string message = "getEntry() called with an empty list or ";
+      message = message + "invalid position.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+}  // end getEntry
+
+
+//if position >= item_count_ returns nullptr; otherwise the block holding the entry at position
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::Block* UnrolledList<T, Capacity>::getPointerTo(size_t position) const
+{
+   Block* find = nullptr;
+   if (position < static_cast<size_t>(item_count_))
+   {
+      int index = 0;
+      find = getBlockAt(static_cast<int>(position), index);
+   }
+
+   return find;
+}  // end getPointerTo
+
+
+//returns the first block, nullptr if the list is empty
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::Block* UnrolledList<T, Capacity>::getHeadNode() const
+{
+   return head_ptr_;
+}  // end getHeadNode
+
+
+/**@return an iterator to the first entry, equal to end() if the list is empty */
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::iterator UnrolledList<T, Capacity>::begin()
+{
+   return iterator(head_ptr_, 0);
+}  // end begin
+
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::const_iterator UnrolledList<T, Capacity>::begin() const
+{
+   return const_iterator(head_ptr_, 0);
+}  // end begin
+
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::const_iterator UnrolledList<T, Capacity>::cbegin() const
+{
+   return const_iterator(head_ptr_, 0);
+}  // end cbegin
+
+
+/**@return an iterator past the last entry */
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::iterator UnrolledList<T, Capacity>::end()
+{
+   return iterator(nullptr, 0);
+}  // end end
+
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::const_iterator UnrolledList<T, Capacity>::end() const
+{
+   return const_iterator(nullptr, 0);
+}  // end end
+
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::const_iterator UnrolledList<T, Capacity>::cend() const
+{
+   return const_iterator(nullptr, 0);
+}  // end cend
+
+
+
+/************* PROTECTED METHODS ************/
+
+
+// Locates the block holding a position.
+// @param position 0 <= position < item_count_, or position == item_count_ for the end of the last block
+// @param index set to the index of position within the block
+// @return the block, or nullptr if the list is empty
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::Block* UnrolledList<T, Capacity>::getBlockAt(int position, int& index) const
+{
+   if (position == item_count_)
+   {
+      // The end of the list is known without walking the chain
+      index = (tail_ptr_ == nullptr) ? 0 : tail_ptr_->count_;
+      return tail_ptr_;
+   }  // end if
+
+   // Skip whole blocks from the beginning of the chain
+   Block* block_ptr = head_ptr_;
+   while (position >= block_ptr->count_)
+   {
+      position -= block_ptr->count_;
+      block_ptr = block_ptr->next_;
+   }  // end while
+
+   index = position;
+   return block_ptr;
+}  // end getBlockAt
+
+
+// Moves the upper half of a full block into a new block linked after it
+// @return the new block
+template<class T, int Capacity>
+typename UnrolledList<T, Capacity>::Block* UnrolledList<T, Capacity>::splitBlock(Block* block_ptr)
+{
+   Block* upper_ptr = new Block();
+   int keep = block_ptr->count_ / 2;
+   for (int i = keep; i < block_ptr->count_; i++)
+   {
+      upper_ptr->items_[i - keep] = std::move(block_ptr->items_[i]);
+      block_ptr->items_[i] = T();
+   }  // end for
+   upper_ptr->count_ = block_ptr->count_ - keep;
+   block_ptr->count_ = keep;
+
+   upper_ptr->next_ = block_ptr->next_;
+   block_ptr->next_ = upper_ptr;
+   if (tail_ptr_ == block_ptr)
+      tail_ptr_ = upper_ptr;
+   return upper_ptr;
+}  // end splitBlock
+
+
+//  End of implementation file.
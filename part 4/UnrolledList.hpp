@@ -0,0 +1,180 @@
+/** ADT list: Unrolled linked list implementation.
+    Each block of the chain holds up to Capacity entries in an array, so a traversal touches one block per
+    Capacity entries instead of one heap node per entry, and positional operations skip whole blocks.
+    The public interface follows LinkedList: positions run from 0 to item_count_ - 1, getEntry throws
+    PrecondViolatedExcep for an invalid position, and getHeadNode returns the first block of the chain.
+    T must be default constructible.
+    @file UnrolledList.hpp */
+
+#ifndef UNROLLED_LIST_
+#define UNROLLED_LIST_
+
+#include "PrecondViolatedExcep.hpp"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+template<class T, int Capacity = 16>
+class UnrolledList
+{
+
+public:
+   /** A block of the chain: up to Capacity entries in list order, and a pointer to the next block */
+   class Block
+   {
+   public:
+      Block() : count_(0), next_(nullptr) {}
+
+      /**@return the number of entries in the block, 1 to Capacity */
+      int getCount() const { return count_; }
+
+      /**@return the entry at index, 0 <= index < getCount() */
+      const T& getItem(int index) const { return items_[index]; }
+      T& getItemRef(int index) { return items_[index]; }
+
+      /**@return the next block, nullptr for the last one */
+      Block* getNext() const { return next_; }
+
+   private:
+      friend class UnrolledList<T, Capacity>;
+
+      T items_[Capacity];
+      int count_;
+      Block* next_;
+   }; // end Block
+
+   /** Forward iterator over the entries in list order; Item is T, or const T for const_iterator */
+   template<class Item>
+   class ListIterator
+   {
+   public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = Item*;
+      using reference = Item&;
+
+      ListIterator() : block_ptr_(nullptr), index_(0) {}
+      ListIterator(Block* block_ptr, int index) : block_ptr_(block_ptr), index_(index) {}
+
+      // An iterator converts to a const_iterator
+      template<class Other, class = std::enable_if_t<std::is_same_v<Other, T> && std::is_const_v<Item>>>
+      ListIterator(const ListIterator<Other>& other) : block_ptr_(other.getBlock()), index_(other.getIndex()) {}
+
+      reference operator*() const { return block_ptr_->items_[index_]; }
+      pointer operator->() const { return &block_ptr_->items_[index_]; }
+
+      ListIterator& operator++()
+      {
+         if (++index_ == block_ptr_->count_)
+         {
+            block_ptr_ = block_ptr_->next_;
+            index_ = 0;
+         }
+         return *this;
+      }
+
+      ListIterator operator++(int)
+      {
+         ListIterator previous = *this;
+         ++*this;
+         return previous;
+      }
+
+      bool operator==(const ListIterator& other) const { return block_ptr_ == other.block_ptr_ && index_ == other.index_; }
+      bool operator!=(const ListIterator& other) const { return !(*this == other); }
+
+      Block* getBlock() const { return block_ptr_; }
+      int getIndex() const { return index_; }
+
+   private:
+      Block* block_ptr_;
+      int index_;
+   }; // end ListIterator
+
+   using iterator = ListIterator<T>;
+   using const_iterator = ListIterator<const T>;
+
+   UnrolledList(); // constructor
+   UnrolledList(const UnrolledList<T, Capacity>& a_list); // copy constructor
+   UnrolledList<T, Capacity>& operator=(UnrolledList<T, Capacity> a_list); // copy-and-swap assignment
+   virtual ~UnrolledList(); // destructor
+
+   /**@return true if list is empty - item_count_ == 0 */
+   bool isEmpty() const;
+
+   /**@return the number of items in the list - item_count_ */
+   int getLength() const;
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param new_entry to be inserted in list
+     @post new_entry is added at position in list (the entry previously at that position is now at position+1).
+           A full block is split in two
+     @return true if valid position (0 <= position <= item_count_) */
+   bool insert(int position, const T& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is the last entry of the list; O(1) through tail_ptr_ */
+   void push_back(const T& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is the first entry of the list */
+   void push_front(const T& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of deletion
+     @post entry at position is deleted, if any. List order is retained. An emptied block is freed,
+           and a block less than a quarter full takes in its successor when both fit in one block
+     @return true if there is an entry at position to be deleted, false otherwise */
+   bool remove(int position);
+
+   /**@post the list is empty and item_count_ == 0*/
+   void clear();
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating the position of the data to be retrieved
+     @return data item found at position. If position is not a valid position < item_count_
+            throws  PrecondViolatedExcep */
+   T getEntry(int position) const;
+
+   //if position >= item_count_ returns nullptr; otherwise the block holding the entry at position
+   Block* getPointerTo(size_t position) const;
+
+   //returns the first block, nullptr if the list is empty
+   Block* getHeadNode() const;
+
+   /**@return an iterator to the first entry, equal to end() if the list is empty */
+   iterator begin();
+   const_iterator begin() const;
+   const_iterator cbegin() const;
+
+   /**@return an iterator past the last entry */
+   iterator end();
+   const_iterator end() const;
+   const_iterator cend() const;
+
+protected:
+   Block* head_ptr_;  // First block of the chain
+   Block* tail_ptr_;  // Last block of the chain, nullptr if empty
+   int item_count_;   // Current count of list items
+
+   // Locates the block holding a position.
+   // @param position 0 <= position < item_count_, or position == item_count_ for the end of the last block
+   // @param index set to the index of position within the block
+   // @return the block, or nullptr if the list is empty
+   Block* getBlockAt(int position, int& index) const;
+
+   // Moves the upper half of a full block into a new block linked after it
+   // @return the new block
+   Block* splitBlock(Block* block_ptr);
+
+}; // end UnrolledList
+
+#include "UnrolledList.cpp"
+#endif
@@ -0,0 +1,360 @@
+/** WorkloadGenerator.hpp defines a seeded generator for synthetic bistro workloads (menus, ingredient stocks,
+    station layouts and order streams) and a small latency recorder used by the benchmark drivers.
+    The generator only depends on the standard library so that every part of the project can share it. **/
+
+#ifndef WORKLOADGENERATOR_HPP
+#define WORKLOADGENERATOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Tunable parameters of a generated workload.
+ */
+struct WorkloadConfig {
+    unsigned seed = 42;                 // Seed for every random choice
+    int num_dishes = 50;                // Size of the menu
+    int num_ingredients = 40;           // Size of the pantry
+    int min_ingredients_per_dish = 2;   // Smallest ingredient list
+    int max_ingredients_per_dish = 5;   // Largest ingredient list
+    int num_stations = 8;               // Number of kitchen stations
+    int stations_per_dish = 1;          // How many stations carry each dish
+    int num_orders = 1000;              // Length of the order stream
+    double zipf_exponent = 1.0;         // Skew of dish popularity (0 = uniform)
+    double vegetarian_rate = 0.10;      // Fraction of orders asking for each accommodation
+    double vegan_rate = 0.05;
+    double gluten_free_rate = 0.05;
+    double nut_free_rate = 0.03;
+    double low_sodium_rate = 0.03;
+    double low_sugar_rate = 0.03;
+    double mean_interarrival = 1.0;     // Mean ticks between arrivals outside a burst
+    double burst_probability = 0.05;    // Chance that an arrival starts a burst
+    int burst_size = 20;                // Orders arriving on the same tick during a burst
+    double station_stock_share = 0.25;  // Fraction of expected demand stocked at the stations
+    double backup_coverage = 1.0;       // Fraction of the remaining demand held in backup stock
+};
+
+/**
+ * An ingredient line: a name with either a stock quantity or a required quantity, and a unit price.
+ */
+struct IngredientSpec {
+    std::string name;
+    int quantity;
+    double price;
+};
+
+/**
+ * A menu item. kind is 0 for an appetizer, 1 for a main course and 2 for a dessert.
+ * cuisine follows the order of Dish::CuisineType.
+ */
+struct DishSpec {
+    std::string name;
+    int kind;
+    std::vector<IngredientSpec> ingredients; // quantity is the required quantity per serving
+    int prep_time;
+    double price;
+    int cuisine;
+};
+
+/**
+ * A station, the menu items it carries (indices into the menu) and its starting stock.
+ */
+struct StationSpec {
+    std::string name;
+    std::vector<int> dish_ids;
+    std::vector<IngredientSpec> stock;
+};
+
+/**
+ * A single ticket in the order stream.
+ */
+struct OrderSpec {
+    int dish_id;          // Index into the menu
+    long arrival_tick;    // Non-decreasing arrival time
+    bool has_request;     // True if any of the accommodations below is set
+    bool vegetarian;
+    bool vegan;
+    bool gluten_free;
+    bool nut_free;
+    bool low_sodium;
+    bool low_sugar;
+};
+
+/**
+ * A complete generated workload.
+ */
+struct Workload {
+    std::vector<DishSpec> menu;
+    std::vector<StationSpec> stations;
+    std::vector<IngredientSpec> backup;
+    std::vector<OrderSpec> orders;
+};
+
+class WorkloadGenerator {
+public:
+    /**
+     * @param config The parameters of the workloads to generate.
+     */
+    explicit WorkloadGenerator(const WorkloadConfig& config) : config_(config), rng_(config.seed) {}
+
+    /**
+     * @return A workload built from the configuration. Calling generate() twice on generators with the same
+     *         configuration yields identical workloads.
+     */
+    Workload generate() {
+        rng_.seed(config_.seed);
+        Workload workload;
+        std::vector<std::string> pantry = makePantry();
+        workload.menu = makeMenu(pantry);
+        workload.orders = makeOrders(static_cast<int>(workload.menu.size()));
+        workload.stations = makeStations(workload.menu, workload.orders);
+        workload.backup = makeBackup(workload.menu, workload.orders);
+        return workload;
+    }
+
+    /**
+     * @param prefix Leading word of the name.
+     * @param index A non-negative number to encode.
+     * @return prefix followed by a space and index written with the letters A-Z, so that the result
+     *         passes Dish name validation (letters and spaces only). Names sort in index order.
+     */
+    static std::string alphaName(const std::string& prefix, int index) {
+        std::string code(4, 'A');
+        for (int pos = 3; pos >= 0; --pos) {
+            code[pos] = static_cast<char>('A' + index % 26);
+            index /= 26;
+        }
+        return prefix + " " + code;
+    }
+
+private:
+    WorkloadConfig config_;
+    std::mt19937_64 rng_;
+
+    double uniform() {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    }
+
+    int uniformInt(int low, int high) {
+        return std::uniform_int_distribution<int>(low, high)(rng_);
+    }
+
+    // Ingredient names. The first few are the names the dietary accommodations look for, so that
+    // accommodated orders actually change their ingredient lists.
+    std::vector<std::string> makePantry() {
+        static const char* known[] = {"Chicken", "Beef", "Fish", "Pork", "Shrimp", "Milk", "Eggs", "Cheese",
+                                      "Butter", "Cream", "Flour", "Bread", "Pasta", "Nuts", "Salt", "Sugar"};
+        std::vector<std::string> pantry;
+        for (int i = 0; i < config_.num_ingredients; ++i) {
+            if (i < static_cast<int>(sizeof(known) / sizeof(known[0]))) {
+                pantry.push_back(known[i]);
+            } else {
+                pantry.push_back(alphaName("Spice", i));
+            }
+        }
+        return pantry;
+    }
+
+    std::vector<DishSpec> makeMenu(const std::vector<std::string>& pantry) {
+        std::vector<DishSpec> menu;
+        for (int i = 0; i < config_.num_dishes; ++i) {
+            DishSpec dish;
+            dish.name = alphaName("Dish", i);
+            dish.kind = uniformInt(0, 2);
+            dish.prep_time = uniformInt(5, 90);
+            dish.price = std::round(uniform() * 4000.0 + 500.0) / 100.0;
+            dish.cuisine = uniformInt(0, 6);
+
+            int count = uniformInt(config_.min_ingredients_per_dish, config_.max_ingredients_per_dish);
+            count = std::min(count, static_cast<int>(pantry.size()));
+            std::vector<int> picks(pantry.size());
+            for (size_t p = 0; p < picks.size(); ++p) {
+                picks[p] = static_cast<int>(p);
+            }
+            for (int k = 0; k < count; ++k) {
+                std::swap(picks[k], picks[uniformInt(k, static_cast<int>(picks.size()) - 1)]);
+                dish.ingredients.push_back({pantry[picks[k]], uniformInt(1, 3), ingredientPrice(picks[k])});
+            }
+            menu.push_back(dish);
+        }
+        return menu;
+    }
+
+    // Unit price of the pantry item at the given index; deterministic so every dish agrees on it.
+    static double ingredientPrice(int index) {
+        return 0.5 + (index * 37 % 20) * 0.25;
+    }
+
+    std::vector<OrderSpec> makeOrders(int menu_size) {
+        // Zipfian popularity: P(rank r) is proportional to 1 / r^s. The menu index doubles as the rank.
+        std::vector<double> cdf(menu_size);
+        double total = 0.0;
+        for (int r = 0; r < menu_size; ++r) {
+            total += 1.0 / std::pow(r + 1.0, config_.zipf_exponent);
+            cdf[r] = total;
+        }
+
+        std::vector<OrderSpec> orders;
+        orders.reserve(config_.num_orders);
+        std::exponential_distribution<double> gap(1.0 / std::max(config_.mean_interarrival, 1e-9));
+        double clock = 0.0;
+        int burst_left = 0;
+        for (int i = 0; i < config_.num_orders; ++i) {
+            if (burst_left > 0) {
+                --burst_left; // Same tick as the previous order
+            } else if (uniform() < config_.burst_probability) {
+                burst_left = config_.burst_size - 1;
+                clock += gap(rng_);
+            } else {
+                clock += gap(rng_);
+            }
+
+            OrderSpec order;
+            double u = uniform() * total;
+            order.dish_id = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin());
+            order.dish_id = std::min(order.dish_id, menu_size - 1);
+            order.arrival_tick = static_cast<long>(clock);
+            order.vegetarian = uniform() < config_.vegetarian_rate;
+            order.vegan = uniform() < config_.vegan_rate;
+            order.gluten_free = uniform() < config_.gluten_free_rate;
+            order.nut_free = uniform() < config_.nut_free_rate;
+            order.low_sodium = uniform() < config_.low_sodium_rate;
+            order.low_sugar = uniform() < config_.low_sugar_rate;
+            order.has_request = order.vegetarian || order.vegan || order.gluten_free || order.nut_free ||
+                                order.low_sodium || order.low_sugar;
+            orders.push_back(order);
+        }
+        return orders;
+    }
+
+    // Total required quantity of each ingredient over the whole order stream.
+    static std::map<std::string, long> demand(const std::vector<DishSpec>& menu, const std::vector<OrderSpec>& orders) {
+        std::map<std::string, long> total;
+        for (const OrderSpec& order : orders) {
+            for (const IngredientSpec& ingredient : menu[order.dish_id].ingredients) {
+                total[ingredient.name] += ingredient.quantity;
+            }
+        }
+        return total;
+    }
+
+    std::vector<StationSpec> makeStations(const std::vector<DishSpec>& menu, const std::vector<OrderSpec>& orders) {
+        std::vector<StationSpec> stations(std::max(config_.num_stations, 1));
+        for (size_t s = 0; s < stations.size(); ++s) {
+            stations[s].name = alphaName("Station", static_cast<int>(s));
+        }
+
+        // Deal every dish to stations_per_dish distinct stations so the whole menu can be served.
+        int copies = std::min(std::max(config_.stations_per_dish, 1), static_cast<int>(stations.size()));
+        for (size_t d = 0; d < menu.size(); ++d) {
+            int first = uniformInt(0, static_cast<int>(stations.size()) - 1);
+            for (int c = 0; c < copies; ++c) {
+                stations[(first + c) % stations.size()].dish_ids.push_back(static_cast<int>(d));
+            }
+        }
+
+        // Each station starts with a share of the demand for the ingredients its dishes use.
+        std::vector<long> dish_orders(menu.size(), 0);
+        for (const OrderSpec& order : orders) {
+            dish_orders[order.dish_id]++;
+        }
+        for (StationSpec& station : stations) {
+            std::map<std::string, IngredientSpec> stock;
+            for (int d : station.dish_ids) {
+                for (const IngredientSpec& ingredient : menu[d].ingredients) {
+                    long needed = dish_orders[d] * ingredient.quantity / copies;
+                    IngredientSpec& line = stock.emplace(ingredient.name, IngredientSpec{ingredient.name, 0, ingredient.price}).first->second;
+                    line.quantity += static_cast<int>(std::ceil(needed * config_.station_stock_share));
+                }
+            }
+            for (const auto& entry : stock) {
+                if (entry.second.quantity > 0) {
+                    station.stock.push_back(entry.second);
+                }
+            }
+        }
+        return stations;
+    }
+
+    std::vector<IngredientSpec> makeBackup(const std::vector<DishSpec>& menu, const std::vector<OrderSpec>& orders) {
+        std::map<std::string, double> prices;
+        for (const DishSpec& dish : menu) {
+            for (const IngredientSpec& ingredient : dish.ingredients) {
+                prices[ingredient.name] = ingredient.price;
+            }
+        }
+        std::vector<IngredientSpec> backup;
+        for (const auto& entry : demand(menu, orders)) {
+            int quantity = static_cast<int>(std::ceil(entry.second * (1.0 - config_.station_stock_share) * config_.backup_coverage));
+            if (quantity > 0) {
+                backup.push_back({entry.first, quantity, prices[entry.first]});
+            }
+        }
+        return backup;
+    }
+};
+
+/**
+ * Collects per-operation latencies and reports throughput and percentiles.
+ */
+class LatencyRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @post Reserves room for count samples. */
+    void reserve(size_t count) { samples_.reserve(count); }
+
+    /** @param nanoseconds The latency of one operation. */
+    void record(uint64_t nanoseconds) { samples_.push_back(nanoseconds); }
+
+    /** @return Nanoseconds elapsed between two time points. */
+    static uint64_t elapsed(Clock::time_point start, Clock::time_point end) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    /** @return The number of recorded samples. */
+    size_t count() const { return samples_.size(); }
+
+    /**
+     * @param label Name of the measured operation.
+     * @param total_nanoseconds Wall time of the whole run, used for ops/sec.
+     * @post Prints one line: label, operation count, ops/sec and the p50/p90/p99/p99.9/max latencies in microseconds.
+     */
+    void report(const std::string& label, uint64_t total_nanoseconds) {
+        std::sort(samples_.begin(), samples_.end());
+        double seconds = total_nanoseconds / 1e9;
+        double ops = seconds > 0 ? samples_.size() / seconds : 0.0;
+        std::cout << std::left << std::setw(28) << label << std::right
+                  << " ops=" << std::setw(8) << samples_.size()
+                  << " ops/sec=" << std::setw(12) << std::fixed << std::setprecision(0) << ops
+                  << std::setprecision(2)
+                  << " p50=" << percentile(0.50) << "us"
+                  << " p90=" << percentile(0.90) << "us"
+                  << " p99=" << percentile(0.99) << "us"
+                  << " p99.9=" << percentile(0.999) << "us"
+                  << " max=" << (samples_.empty() ? 0.0 : samples_.back() / 1e3) << "us" << std::endl;
+    }
+
+private:
+    std::vector<uint64_t> samples_;
+
+    // Nearest-rank percentile in microseconds; samples_ must be sorted.
+    double percentile(double p) const {
+        if (samples_.empty()) {
+            return 0.0;
+        }
+        size_t rank = static_cast<size_t>(std::ceil(p * samples_.size()));
+        rank = std::min(std::max<size_t>(rank, 1), samples_.size());
+        return samples_[rank - 1] / 1e3;
+    }
+};
+
+#endif // WORKLOADGENERATOR_HPP
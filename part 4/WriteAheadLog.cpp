@@ -0,0 +1,320 @@
+// WriteAheadLog.cpp contains the record encoding and the group-committing writer of the WriteAheadLog.
+#include "WriteAheadLog.hpp"
+#include "StationSnapshot.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+// Frame: body length, CRC-32 of the body, body
+const size_t FRAME_HEADER = 8;
+const uint32_t MAX_BODY = 64 * 1024 * 1024;
+
+uint32_t crc32(const char* data, size_t size) {
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> entries(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            entries[i] = value;
+        }
+        return entries;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+template <typename Value>
+void put(std::string& out, Value value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void putString(std::string& out, const std::string& text) {
+    put<uint32_t>(out, static_cast<uint32_t>(text.size()));
+    out += text;
+}
+
+// Bounds-checked reader over one record body
+class Reader {
+public:
+    Reader(const char* data, size_t size) : data_(data), size_(size), offset_(0) {}
+
+    template <typename Value>
+    bool get(Value& value) {
+        if (size_ - offset_ < sizeof(value)) {
+            return false;
+        }
+        std::memcpy(&value, data_ + offset_, sizeof(value));
+        offset_ += sizeof(value);
+        return true;
+    }
+
+    bool getString(std::string& text) {
+        uint32_t length;
+        if (!get(length) || size_ - offset_ < length) {
+            return false;
+        }
+        text.assign(data_ + offset_, length);
+        offset_ += length;
+        return true;
+    }
+
+    bool done() const { return offset_ == size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t offset_;
+};
+
+void encodeBody(std::string& out, const WalRecord& record, uint64_t sequence) {
+    put<uint64_t>(out, sequence);
+    put<uint8_t>(out, record.type);
+    putString(out, record.station);
+    putString(out, record.merged_station);
+    putString(out, record.dish);
+    putString(out, record.ingredient.name);
+    put<int32_t>(out, record.ingredient.quantity);
+    put<int32_t>(out, record.ingredient.required_quantity);
+    put<double>(out, record.ingredient.price);
+    put<int32_t>(out, record.quantity);
+    put<uint32_t>(out, static_cast<uint32_t>(record.positions.size()));
+    for (uint32_t position : record.positions) {
+        put<uint32_t>(out, position);
+    }
+    putString(out, record.dish_image);
+}
+
+bool decodeBody(const char* data, size_t size, WalRecord& record) {
+    Reader in(data, size);
+    uint8_t type;
+    int32_t quantity, required_quantity, count_quantity;
+    uint32_t positions;
+    if (!in.get(record.sequence) || !in.get(type) || type < WalRecord::ENQUEUE || type > WalRecord::STATION_MERGE ||
+        !in.getString(record.station) || !in.getString(record.merged_station) || !in.getString(record.dish) || !in.getString(record.ingredient.name) ||
+        !in.get(quantity) || !in.get(required_quantity) || !in.get(record.ingredient.price) ||
+        !in.get(count_quantity) || !in.get(positions) || positions > size / sizeof(uint32_t)) {
+        return false;
+    }
+    record.type = static_cast<WalRecord::Type>(type);
+    record.ingredient.quantity = quantity;
+    record.ingredient.required_quantity = required_quantity;
+    record.quantity = count_quantity;
+    record.positions.resize(positions);
+    for (uint32_t& position : record.positions) {
+        if (!in.get(position)) {
+            return false;
+        }
+    }
+    return in.getString(record.dish_image) && in.done();
+}
+
+// Parses complete, intact frames from the start of a log; returns the end of the last one
+size_t parseLog(const std::string& log, std::vector<WalRecord>* records, uint64_t after_sequence, uint64_t& last_sequence) {
+    size_t offset = 0;
+    last_sequence = 0;
+    while (log.size() - offset >= FRAME_HEADER) {
+        uint32_t length, crc;
+        std::memcpy(&length, log.data() + offset, sizeof(length));
+        std::memcpy(&crc, log.data() + offset + 4, sizeof(crc));
+        if (length > MAX_BODY || log.size() - offset - FRAME_HEADER < length) {
+            break; // Torn write
+        }
+        const char* body = log.data() + offset + FRAME_HEADER;
+        WalRecord record;
+        if (crc32(body, length) != crc || !decodeBody(body, length, record) || record.sequence <= last_sequence) {
+            break; // Corrupt record
+        }
+        last_sequence = record.sequence;
+        if (records != nullptr && record.sequence > after_sequence) {
+            records->push_back(std::move(record));
+        }
+        offset += FRAME_HEADER + length;
+    }
+    return offset;
+}
+
+bool readFile(const std::string& filename, std::string& contents) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace
+
+WalRecord::WalRecord(Type type) : type(type), sequence(0), ingredient("", 0, 0, 0.0), quantity(0) {
+}
+
+// Encodes a queued dish as a snapshot holding only that dish
+void WalRecord::setDish(const Dish& queued) {
+    SnapshotBuilder builder;
+    builder.addQueuedDish(queued);
+    dish_image = builder.image();
+}
+
+// Decodes dish_image; the copy gives SnapshotImage the 8-byte alignment it needs
+Dish* WalRecord::makeDish() const {
+    std::vector<uint64_t> buffer((dish_image.size() + 7) / 8);
+    std::memcpy(buffer.data(), dish_image.data(), dish_image.size());
+    SnapshotImage image;
+    if (!image.openBuffer(reinterpret_cast<const char*>(buffer.data()), dish_image.size()) ||
+        image.header().queue_count != 1) {
+        return nullptr;
+    }
+    return image.makeDish(image.dishes()[image.header().queue_first]);
+}
+
+// Opens the log, cutting off a torn tail, and starts the writer unless every append syncs itself
+WriteAheadLog::WriteAheadLog(const std::string& filename, Durability durability, size_t group_bytes, int group_interval_ms)
+    : filename_(filename), durability_(durability), group_bytes_(group_bytes), group_interval_ms_(group_interval_ms),
+      descriptor_(-1), last_sequence_(0), committed_sequence_(0), sync_count_(0), flush_requested_(false),
+      failed_(false), stopping_(false) {
+    std::string existing;
+    if (readFile(filename, existing)) {
+        size_t valid = parseLog(existing, nullptr, 0, last_sequence_);
+        if (valid < existing.size() && truncate(filename.c_str(), static_cast<off_t>(valid)) != 0) {
+            throw std::runtime_error("Cannot truncate write-ahead log " + filename);
+        }
+    }
+    committed_sequence_ = last_sequence_;
+    descriptor_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (descriptor_ < 0) {
+        throw std::runtime_error("Cannot open write-ahead log " + filename);
+    }
+    pending_.reserve(group_bytes_ + 4096);
+    if (durability_ != SYNC_EVERY_RECORD) {
+        writer_ = std::thread(&WriteAheadLog::run, this);
+    }
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        writer_.join();
+    }
+    close(descriptor_);
+}
+
+// Frames the record into the group buffer; only a full buffer wakes the writer
+uint64_t WriteAheadLog::append(const WalRecord& record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t sequence = ++last_sequence_;
+    size_t frame = pending_.size();
+    pending_.append(FRAME_HEADER, '\0');
+    encodeBody(pending_, record, sequence);
+    uint32_t length = static_cast<uint32_t>(pending_.size() - frame - FRAME_HEADER);
+    uint32_t crc = crc32(pending_.data() + frame + FRAME_HEADER, length);
+    std::memcpy(&pending_[frame], &length, sizeof(length));
+    std::memcpy(&pending_[frame + 4], &crc, sizeof(crc));
+
+    if (durability_ == SYNC_EVERY_RECORD) {
+        failed_ = !writeOut(pending_) || failed_;
+        pending_.clear();
+        committed_sequence_ = sequence;
+    } else if (pending_.size() >= group_bytes_ && frame < group_bytes_) {
+        wake_.notify_one();
+    }
+    return sequence;
+}
+
+bool WriteAheadLog::commit() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t target = last_sequence_;
+    if (committed_sequence_ < target) {
+        flush_requested_ = true;
+        wake_.notify_one();
+        committed_.wait(lock, [this, target] { return committed_sequence_ >= target; });
+    }
+    return !failed_;
+}
+
+uint64_t WriteAheadLog::lastSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_sequence_;
+}
+
+uint64_t WriteAheadLog::committedSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return committed_sequence_;
+}
+
+long WriteAheadLog::getSyncCount() const {
+    return sync_count_.load(std::memory_order_relaxed);
+}
+
+// Writer thread: every interval, or sooner when the buffer fills or a commit waits, writes the group and syncs once
+void WriteAheadLog::run() {
+    std::string batch;
+    batch.reserve(group_bytes_ + 4096);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait_for(lock, std::chrono::milliseconds(group_interval_ms_), [this] {
+            return stopping_ || flush_requested_ || pending_.size() >= group_bytes_;
+        });
+        if (pending_.empty()) {
+            if (stopping_) {
+                break;
+            }
+            continue;
+        }
+        batch.swap(pending_);
+        flush_requested_ = false;
+        uint64_t target = last_sequence_;
+        lock.unlock();
+        bool written = writeOut(batch);
+        batch.clear();
+        lock.lock();
+        failed_ = !written || failed_;
+        committed_sequence_ = target;
+        committed_.notify_all();
+    }
+}
+
+// Writes a group with as few write calls as the kernel allows, then syncs it unless durability is NO_SYNC
+bool WriteAheadLog::writeOut(const std::string& batch) {
+    size_t written = 0;
+    while (written < batch.size()) {
+        ssize_t result = ::write(descriptor_, batch.data() + written, batch.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    if (durability_ == NO_SYNC) {
+        return true;
+    }
+    sync_count_.fetch_add(1, std::memory_order_relaxed);
+    return fdatasync(descriptor_) == 0;
+}
+
+// Reads every intact record after after_sequence
+bool WriteAheadLog::readAll(const std::string& filename, std::vector<WalRecord>& records, uint64_t after_sequence) {
+    std::string log;
+    if (!readFile(filename, log)) {
+        return false;
+    }
+    uint64_t last_sequence;
+    parseLog(log, &records, after_sequence, last_sequence);
+    return true;
+}
@@ -0,0 +1,144 @@
+/** Header file for the WriteAheadLog, an append-only log of the StationManager mutations made since the last
+    snapshot. Each record is framed as length, CRC-32 and body, and carries a sequence number; a snapshot stores
+    the sequence it includes, so recovery restores the snapshot and replays only the records after it.
+    Appends go to a memory buffer; a writer thread commits them in groups with one write and one fsync. **/
+
+#ifndef WRITEAHEADLOG_HPP
+#define WRITEAHEADLOG_HPP
+
+#include "Dish.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct WalRecord {
+    /**
+     * ENQUEUE: a dish (after dietary accommodations) joins the back of the queue.
+     * QUEUE_REMOVE: the dishes at positions are prepared and leave the queue, which held quantity dishes before;
+     * QUEUE_CLEAR empties it.
+     * PREPARE: station prepares dish once (quantity 0, KitchenStation::prepareDish) or quantity servings
+     * (KitchenStation::prepareDishes).
+     * STOCK_ADD: ingredient is added to the stock of station from outside the backup stock.
+     * BACKUP_TRANSFER: ingredient.quantity of ingredient.name moves from backup to station at ingredient.price.
+     * BACKUP_ADD: ingredient is added to the backup stock; BACKUP_CLEAR empties it.
+     * STATION_MERGE: merged_station is merged into station (StationManager::mergeStations).
+     */
+    enum Type : uint8_t { ENQUEUE = 1, QUEUE_REMOVE, QUEUE_CLEAR, PREPARE, STOCK_ADD, BACKUP_TRANSFER, BACKUP_ADD, BACKUP_CLEAR,
+                          STATION_MERGE };
+
+    Type type;
+    uint64_t sequence;                ///< Assigned by WriteAheadLog::append
+    std::string station;
+    std::string merged_station;       ///< STATION_MERGE: the station absorbed into station
+    std::string dish;                 ///< PREPARE: the dish name
+    Ingredient ingredient;
+    int quantity;
+    std::vector<uint32_t> positions;  ///< QUEUE_REMOVE: queue positions before the removal, ascending
+    std::string dish_image;           ///< ENQUEUE: the dish as a one-dish snapshot image
+
+    explicit WalRecord(Type type = QUEUE_CLEAR);
+
+    /**
+     * Encodes a queued dish into dish_image; a dish that is not an Appetizer, MainCourse or Dessert keeps only
+     * its Dish fields and is replayed as a PlainDish.
+     */
+    void setDish(const Dish& queued);
+
+    /**
+     * @return: A new dish decoded from dish_image that the caller owns, or nullptr if the image is invalid.
+     */
+    Dish* makeDish() const;
+};
+
+class WriteAheadLog {
+
+public:
+    /**
+     * How long an appended record may stay only in memory.
+     * NO_SYNC hands groups to the operating system without fsync; GROUP_COMMIT fsyncs every group, so a record is
+     * durable at most group_interval_ms after it was appended; SYNC_EVERY_RECORD writes and fsyncs inside append.
+     */
+    enum Durability { NO_SYNC, GROUP_COMMIT, SYNC_EVERY_RECORD };
+
+    /**
+     * Opens or creates a log for appending. A torn record at the end of an existing log is cut off and numbering
+     * continues after its last complete record.
+     * @param group_bytes Buffered bytes that wake the writer before group_interval_ms has passed.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    explicit WriteAheadLog(const std::string& filename, Durability durability = GROUP_COMMIT,
+                           size_t group_bytes = 64 * 1024, int group_interval_ms = 2);
+
+    /**
+     * Commits every appended record and stops the writer.
+     */
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    /**
+     * Appends a record. Unless the durability is SYNC_EVERY_RECORD, this only copies the record into the
+     * group buffer.
+     * @return: The sequence number given to the record.
+     */
+    uint64_t append(const WalRecord& record);
+
+    /**
+     * Blocks until every record appended so far has been written (and fsynced unless the durability is NO_SYNC).
+     * @return: False if a write or fsync failed.
+     */
+    bool commit();
+
+    /**
+     * @return: The sequence number of the last appended record, 0 if none.
+     */
+    uint64_t lastSequence() const;
+
+    /**
+     * @return: The sequence number of the last committed record.
+     */
+    uint64_t committedSequence() const;
+
+    /**
+     * @return: The number of fsync calls made so far; appended records divided by this is the group size.
+     */
+    long getSyncCount() const;
+
+    Durability getDurability() const { return durability_; }
+
+    /**
+     * Reads the records of a log, stopping at the first torn or corrupt record.
+     * @param after_sequence Records with this sequence number or lower are skipped.
+     * @return: False if the file cannot be opened.
+     */
+    static bool readAll(const std::string& filename, std::vector<WalRecord>& records, uint64_t after_sequence = 0);
+
+private:
+    void run();
+    bool writeOut(const std::string& batch);
+
+    std::string filename_;
+    Durability durability_;
+    size_t group_bytes_;
+    int group_interval_ms_;
+    int descriptor_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;       ///< Wakes the writer early when the group buffer is full or on commit
+    std::condition_variable committed_;  ///< Signalled after every group is written
+    std::string pending_;                ///< Encoded records not yet handed to the writer
+    uint64_t last_sequence_;
+    uint64_t committed_sequence_;
+    std::atomic<long> sync_count_;
+    bool flush_requested_;               ///< A commit() is waiting, so the writer should not wait for the interval
+    bool failed_;
+    bool stopping_;
+    std::thread writer_;
+};
+
+#endif
@@ -0,0 +1,563 @@
+// bench.cpp drives StationManager with generated workloads and prints throughput and latency percentiles.
+// Usage: ./bench [orders] [seed] [trace.json]   (without arguments it sweeps 10^3, 10^4 and 10^5 orders)
+// With a trace file, order tracing is on and the most recent events are written as Chrome trace_event JSON.
+// Every scale runs with the default per-dish processing under each station ordering and routing policy, with
+// batch cooking and with replenishment planning, with and without order parking on a short backup stock, and
+// then through the coroutine OrderPipeline. Last, LinkedList, UnrolledList and IndexedSkipList are compared as
+// station lists of 10^4 to 10^5 stations, and routing lookups on several threads are timed while an admin thread
+// reconfigures the stations, with a LinkedList behind a shared_mutex and with an RcuList.
+
+#include "StationManager.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "WorkloadGenerator.hpp"
+#include "OrderPipeline.hpp"
+#include "UnrolledList.hpp"
+#include "IndexedSkipList.hpp"
+#include "RcuList.hpp"
+#include <atomic>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// Builds the concrete dish described by spec.
+Dish* makeDish(const DishSpec& spec) {
+    std::vector<Ingredient> ingredients;
+    for (const IngredientSpec& ingredient : spec.ingredients) {
+        ingredients.push_back(Ingredient(ingredient.name, ingredient.quantity, ingredient.quantity, ingredient.price));
+    }
+    Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(spec.cuisine);
+    switch (spec.kind) {
+        case 0:
+            return new Appetizer(spec.name, ingredients, spec.prep_time, spec.price, cuisine, Appetizer::PLATED, 2, false);
+        case 1:
+            return new MainCourse(spec.name, ingredients, spec.prep_time, spec.price, cuisine, MainCourse::GRILLED, "Chicken", {}, false);
+        default:
+            return new Dessert(spec.name, ingredients, spec.prep_time, spec.price, cuisine, Dessert::SWEET, 5, false);
+    }
+}
+
+Dish::DietaryRequest toRequest(const OrderSpec& order) {
+    Dish::DietaryRequest request;
+    request.vegetarian = order.vegetarian;
+    request.vegan = order.vegan;
+    request.gluten_free = order.gluten_free;
+    request.nut_free = order.nut_free;
+    request.low_sodium = order.low_sodium;
+    request.low_sugar = order.low_sugar;
+    return request;
+}
+
+// Creates the stations of the workload and registers them with the manager; with_backup false leaves the backup empty.
+std::vector<KitchenStation*> buildKitchen(StationManager& manager, const Workload& workload, bool with_backup = true) {
+    std::vector<KitchenStation*> stations;
+    for (const StationSpec& spec : workload.stations) {
+        KitchenStation* station = new KitchenStation(spec.name);
+        for (int dish_id : spec.dish_ids) {
+            station->assignDishToStation(makeDish(workload.menu[dish_id]));
+        }
+        for (const IngredientSpec& ingredient : spec.stock) {
+            station->replenishStationIngredients(Ingredient(ingredient.name, ingredient.quantity, 0, ingredient.price));
+        }
+        manager.addStation(station);
+        stations.push_back(station);
+    }
+    std::vector<Ingredient> backup;
+    for (const IngredientSpec& ingredient : workload.backup) {
+        backup.push_back(Ingredient(ingredient.name, ingredient.quantity, 0, ingredient.price));
+    }
+    if (with_backup) {
+        manager.addBackupIngredients(backup);
+    }
+    return stations;
+}
+
+enum Mode { PER_DISH, BATCH_COOKING, PLANNED, PARKED_ORDERS };
+
+const char* orderingName(StationManager::StationOrdering ordering) {
+    switch (ordering) {
+        case StationManager::MOVE_TO_FRONT: return "move-to-front";
+        case StationManager::TRANSPOSE: return "transpose";
+        case StationManager::FREQUENCY_COUNT: return "frequency count";
+        default: return "fixed";
+    }
+}
+
+const char* routingName(StationManager::StationRouting routing) {
+    switch (routing) {
+        case StationManager::MOST_SERVINGS: return "most servings";
+        case StationManager::LEAST_BUSY: return "least busy";
+        default: return "first fit";
+    }
+}
+
+void runScale(int num_orders, unsigned seed, Mode mode, StationManager::StationOrdering ordering,
+              StationManager::StationRouting routing = StationManager::FIRST_FIT, double backup_coverage = 1.0) {
+    WorkloadConfig config;
+    config.seed = seed;
+    config.num_orders = num_orders;
+    config.num_dishes = std::min(50 + num_orders / 200, 2000);
+    config.num_stations = std::min(8 + num_orders / 2000, 64);
+    config.stations_per_dish = 3;
+    config.backup_coverage = backup_coverage;
+    Workload workload = WorkloadGenerator(config).generate();
+
+    std::cout << "== " << num_orders << " orders, " << workload.menu.size() << " dishes, "
+              << workload.stations.size() << " stations (seed " << seed << ")"
+              << (mode == BATCH_COOKING ? ", batch cooking" : mode == PLANNED ? ", planned replenishment" : "")
+              << (mode == PARKED_ORDERS ? ", parked orders" : "")
+              << (backup_coverage < 1.0 ? ", backup covers " + std::to_string(static_cast<int>(backup_coverage * 100)) + "%" : "")
+              << ", " << orderingName(ordering) << " stations, " << routingName(routing) << " routing ==" << std::endl;
+
+    StationManager manager;
+    manager.setBatchCooking(mode == BATCH_COOKING);
+    manager.setReplenishmentPlanning(mode == PLANNED);
+    manager.setOrderParking(mode == PARKED_ORDERS);
+    manager.setStationOrdering(ordering);
+    manager.setStationRouting(routing);
+    manager.setEventSink(std::make_shared<NullEventSink>()); // Benchmarks run with logging off
+    std::vector<KitchenStation*> stations = buildKitchen(manager, workload);
+    std::vector<std::unique_ptr<Dish>> tickets;
+    tickets.reserve(workload.orders.size());
+
+    LatencyRecorder enqueue;
+    LatencyRecorder end_to_end;
+    LatencyRecorder batches;
+    enqueue.reserve(workload.orders.size());
+    end_to_end.reserve(workload.orders.size());
+
+    // Service loop: every tick enqueues the arrivals of that tick and then processes the queue.
+    // Latency is measured on a service clock that only advances while StationManager is working.
+    uint64_t service_clock = 0;
+    uint64_t enqueue_total = 0;
+    std::vector<std::pair<Dish*, uint64_t>> pending; // ticket and its enqueue time on the service clock
+    size_t next = 0;
+    while (next < workload.orders.size()) {
+        long tick = workload.orders[next].arrival_tick;
+        for (; next < workload.orders.size() && workload.orders[next].arrival_tick == tick; ++next) {
+            const OrderSpec& order = workload.orders[next];
+            tickets.emplace_back(makeDish(workload.menu[order.dish_id]));
+            Dish* ticket = tickets.back().get();
+
+            auto start = LatencyRecorder::Clock::now();
+            if (order.has_request) {
+                manager.addDishToQueue(ticket, toRequest(order));
+            } else {
+                manager.addDishToQueue(ticket);
+            }
+            uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+            enqueue.record(spent);
+            enqueue_total += spent;
+            service_clock += spent;
+            pending.push_back({ticket, service_clock});
+        }
+
+        auto start = LatencyRecorder::Clock::now();
+        manager.processAllDishes();
+        uint64_t spent = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        batches.record(spent);
+        service_clock += spent;
+
+        // Tickets that left the queue were prepared during this batch.
+        std::queue<Dish*> remaining = manager.getDishQueue();
+        std::unordered_set<Dish*> still_queued;
+        while (!remaining.empty()) {
+            still_queued.insert(remaining.front());
+            remaining.pop();
+        }
+        std::vector<std::pair<Dish*, uint64_t>> waiting;
+        for (const auto& entry : pending) {
+            if (still_queued.count(entry.first)) {
+                waiting.push_back(entry);
+            } else {
+                end_to_end.record(service_clock - entry.second);
+            }
+        }
+        pending.swap(waiting);
+    }
+
+    // Read-only routing queries against the final kitchen.
+    LatencyRecorder lookups;
+    lookups.reserve(workload.orders.size());
+    auto lookup_start = LatencyRecorder::Clock::now();
+    size_t found = 0;
+    for (const OrderSpec& order : workload.orders) {
+        auto start = LatencyRecorder::Clock::now();
+        found += manager.findStation(workload.stations[order.dish_id % workload.stations.size()].name) != nullptr;
+        found += manager.canCompleteOrder(workload.menu[order.dish_id].name);
+        lookups.record(LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now()));
+    }
+    uint64_t lookup_total = LatencyRecorder::elapsed(lookup_start, LatencyRecorder::Clock::now());
+
+    enqueue.report("addDishToQueue", enqueue_total);
+    end_to_end.report("order end-to-end", service_clock);
+    batches.report("processAllDishes batch", service_clock - enqueue_total);
+    lookups.report("findStation+canComplete", lookup_total);
+    std::cout << "prepared " << end_to_end.count() << " / " << workload.orders.size()
+              << ", still queued " << pending.size() << " (lookup hits " << found << ")" << std::endl;
+    if (manager.getRoutingCount() > 0) {
+        std::cout << "station probes per routed dish " << static_cast<double>(manager.getRoutingProbeCount()) / manager.getRoutingCount() << std::endl;
+    }
+    int min_busy = -1;
+    int max_busy = 0;
+    for (KitchenStation* station : stations) {
+        int busy = manager.getStationBusyTime(station->getName());
+        min_busy = min_busy < 0 ? busy : std::min(min_busy, busy);
+        max_busy = std::max(max_busy, busy);
+    }
+    long replenishments = 0;
+    long backup_misses = 0;
+    MetricsSnapshot metrics = manager.getMetricsSnapshot();
+    for (const MetricsSnapshot::Entry& entry : metrics.stations) {
+        replenishments += entry.replenishments;
+        backup_misses += entry.backup_misses;
+    }
+    std::cout << "station busy time min " << min_busy << " max " << max_busy
+              << ", backup stock value left " << manager.getBackupStockValue() << std::endl;
+    std::cout << "backup replenishments " << replenishments << ", backup misses " << backup_misses
+              << ", queue high-water " << metrics.queue_high_water << std::endl << std::endl;
+
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+}
+
+// Submits every order at once to an OrderPipeline with an empty backup stock, so orders that outrun the station
+// stock suspend; the backup is then delivered through the pipeline, which wakes only the orders it can help.
+void runPipeline(int num_orders, unsigned seed, size_t worker_threads) {
+    WorkloadConfig config;
+    config.seed = seed;
+    config.num_orders = num_orders;
+    config.num_dishes = std::min(50 + num_orders / 200, 2000);
+    config.num_stations = std::min(8 + num_orders / 2000, 64);
+    config.stations_per_dish = 3;
+    Workload workload = WorkloadGenerator(config).generate();
+
+    std::cout << "== " << num_orders << " orders, " << workload.menu.size() << " dishes, "
+              << workload.stations.size() << " stations (seed " << seed << "), coroutine pipeline on "
+              << worker_threads + 1 << " thread(s) ==" << std::endl;
+
+    StationManager manager;
+    manager.setEventSink(std::make_shared<NullEventSink>());
+    std::vector<KitchenStation*> stations = buildKitchen(manager, workload, false);
+    size_t waited;
+    size_t high_water;
+    size_t drained;
+    long completed;
+    uint64_t intake_ns;
+    uint64_t delivery_ns;
+    {
+        PipelineExecutor executor(worker_threads);
+        OrderPipeline pipeline(manager, executor);
+
+        auto start = LatencyRecorder::Clock::now();
+        for (const OrderSpec& order : workload.orders) {
+            Dish* ticket = makeDish(workload.menu[order.dish_id]);
+            if (order.has_request) {
+                pipeline.submit(ticket, toRequest(order));
+            } else {
+                pipeline.submit(ticket);
+            }
+        }
+        executor.run();
+        intake_ns = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        waited = pipeline.getWaitingForStockCount();
+
+        start = LatencyRecorder::Clock::now();
+        for (const IngredientSpec& ingredient : workload.backup) {
+            pipeline.addBackupIngredient(Ingredient(ingredient.name, ingredient.quantity, 0, ingredient.price));
+        }
+        executor.run();
+        delivery_ns = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+        high_water = pipeline.getInFlightHighWater();
+        completed = pipeline.getCompletedCount();
+        drained = pipeline.drain();
+    }
+
+    std::cout << "completed " << completed << " / " << workload.orders.size() << ", in flight high-water " << high_water
+              << ", waiting for stock before the backup delivery " << waited << ", drained to the queue " << drained << std::endl;
+    std::cout << "first pass " << intake_ns / 1e6 << " ms, backup delivery and wake-ups " << delivery_ns / 1e6 << " ms"
+              << std::endl << std::endl;
+
+    manager.clearDishQueue();
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+}
+
+// Times the list operations StationManager relies on over a list of stations: building it in order, a full
+// traversal, a findStation-style scan by name, positional getEntry and insert/remove in the middle.
+template <class StationList>
+void runList(const char* list_name, const std::vector<KitchenStation*>& stations, unsigned seed) {
+    const int count = static_cast<int>(stations.size());
+    const int probes = 1000;
+    std::mt19937 rng(seed);
+    std::vector<int> positions(probes);
+    for (int& position : positions) {
+        position = static_cast<int>(rng() % count);
+    }
+
+    auto start = LatencyRecorder::Clock::now();
+    StationList list;
+    for (KitchenStation* station : stations) {
+        list.push_back(station);
+    }
+    uint64_t build_ns = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+
+    start = LatencyRecorder::Clock::now();
+    size_t checksum = 0;
+    for (int pass = 0; pass < 20; ++pass) {
+        for (KitchenStation* station : list) {
+            checksum += reinterpret_cast<uintptr_t>(station) >> 4;
+        }
+    }
+    uint64_t traverse_ns = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now()) / 20;
+
+    // The last station is the worst case of a linear scan
+    const std::string& wanted = stations.back()->getName();
+    start = LatencyRecorder::Clock::now();
+    for (int pass = 0; pass < 5; ++pass) {
+        for (KitchenStation* station : list) {
+            if (station->getName() == wanted) {
+                checksum++;
+                break;
+            }
+        }
+    }
+    uint64_t find_ns = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now()) / 5;
+
+    start = LatencyRecorder::Clock::now();
+    for (int position : positions) {
+        checksum += reinterpret_cast<uintptr_t>(list.getEntry(position)) >> 4;
+    }
+    uint64_t get_ns = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now()) / probes;
+
+    start = LatencyRecorder::Clock::now();
+    for (int position : positions) {
+        list.insert(position, stations[position]);
+        list.remove(position);
+    }
+    uint64_t update_ns = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now()) / probes;
+
+    std::cout << list_name << ": build " << build_ns / 1e6 << " ms, traversal " << traverse_ns / 1e3
+              << " us, find by name " << find_ns / 1e3 << " us, getEntry " << get_ns / 1e3
+              << " us, insert+remove " << update_ns / 1e3 << " us (checksum " << checksum % 1000 << ")" << std::endl;
+}
+
+void runListComparison(int num_stations, unsigned seed) {
+    std::cout << "== " << num_stations << " stations, LinkedList vs UnrolledList vs IndexedSkipList ==" << std::endl;
+    std::vector<KitchenStation*> stations;
+    stations.reserve(num_stations);
+    for (int i = 0; i < num_stations; ++i) {
+        stations.push_back(new KitchenStation("Station " + std::to_string(i)));
+    }
+    runList<LinkedList<KitchenStation*>>("LinkedList", stations, seed);
+    runList<UnrolledList<KitchenStation*>>("UnrolledList", stations, seed);
+    runList<IndexedSkipList<KitchenStation*>>("IndexedSkipList", stations, seed);
+    std::cout << std::endl;
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+}
+
+// A LinkedList of stations that readers share and the admin thread locks exclusively
+struct LockedStationList {
+    LinkedList<KitchenStation*> list;
+    mutable std::shared_mutex mutex;
+
+    template <class Visit>
+    void forEach(Visit visit) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        for (KitchenStation* station : list) {
+            if (visit(station)) {
+                break;
+            }
+        }
+    }
+
+    void push_back(KitchenStation* station) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        list.push_back(station);
+    }
+
+    // The admin operations: take a station out and add it back at the end, or move one to the front
+    void reAdd(int position) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        KitchenStation* station = list.getEntry(position);
+        list.remove(position);
+        list.push_back(station);
+    }
+
+    void moveToFront(int position) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        LinkedList<KitchenStation*>::iterator station = list.begin();
+        std::advance(station, position);
+        list.moveToFront(station.getNode());
+    }
+};
+
+// The same operations on an RcuList, whose readers take no lock
+struct RcuStationList {
+    RcuList<KitchenStation*> list;
+
+    template <class Visit>
+    void forEach(Visit visit) const {
+        RcuList<KitchenStation*>::Snapshot snapshot = list.read();
+        for (KitchenStation* station : snapshot) {
+            if (visit(station)) {
+                break;
+            }
+        }
+    }
+
+    void push_back(KitchenStation* station) { list.push_back(station); }
+
+    void reAdd(int position) {
+        list.update([position](std::vector<KitchenStation*>& stations) {
+            KitchenStation* station = stations[position];
+            stations.erase(stations.begin() + position);
+            stations.push_back(station);
+            return true;
+        });
+    }
+
+    void moveToFront(int position) { list.moveToFront(position); }
+};
+
+// Routing threads look stations up by name while, if reconfigure is set, an admin thread keeps re-adding
+// stations and moving them to the front; prints the lookup latency percentiles.
+template <class SharedStations>
+void runRouting(const char* label, const std::vector<KitchenStation*>& stations, unsigned seed, bool reconfigure) {
+    const int readers = 3;
+    const int lookups = 20000;
+    const int count = static_cast<int>(stations.size());
+    SharedStations shared;
+    for (KitchenStation* station : stations) {
+        shared.push_back(station);
+    }
+
+    std::atomic<int> readers_done{0};
+    std::thread admin;
+    long admin_ops = 0;
+    if (reconfigure) {
+        admin = std::thread([&] {
+            std::mt19937 rng(seed);
+            while (readers_done.load() < readers) {
+                int position = static_cast<int>(rng() % count);
+                if (admin_ops % 2 == 0) {
+                    shared.reAdd(position);
+                } else {
+                    shared.moveToFront(position);
+                }
+                ++admin_ops;
+            }
+        });
+    }
+
+    std::vector<std::vector<uint64_t>> samples(readers);
+    std::vector<std::thread> routers;
+    auto start = LatencyRecorder::Clock::now();
+    for (int r = 0; r < readers; ++r) {
+        routers.emplace_back([&, r] {
+            std::mt19937 rng(seed + 1 + r);
+            samples[r].reserve(lookups);
+            for (int i = 0; i < lookups; ++i) {
+                const std::string& wanted = stations[rng() % count]->getName();
+                auto lookup_start = LatencyRecorder::Clock::now();
+                KitchenStation* found = nullptr;
+                shared.forEach([&](KitchenStation* station) {
+                    if (station->getName() == wanted) {
+                        found = station;
+                    }
+                    return found != nullptr;
+                });
+                samples[r].push_back(LatencyRecorder::elapsed(lookup_start, LatencyRecorder::Clock::now()));
+                if (found == nullptr) {
+                    std::cerr << label << ": station " << wanted << " not found" << std::endl;
+                }
+            }
+            readers_done.fetch_add(1);
+        });
+    }
+    for (std::thread& router : routers) {
+        router.join();
+    }
+    uint64_t total_ns = LatencyRecorder::elapsed(start, LatencyRecorder::Clock::now());
+    if (admin.joinable()) {
+        admin.join();
+    }
+
+    LatencyRecorder recorder;
+    recorder.reserve(readers * lookups);
+    for (const std::vector<uint64_t>& thread_samples : samples) {
+        for (uint64_t sample : thread_samples) {
+            recorder.record(sample);
+        }
+    }
+    recorder.report(std::string(label) + (reconfigure ? " reconfiguring" : " quiet"), total_ns);
+    if (reconfigure) {
+        std::cout << "  admin operations during the run: " << admin_ops << std::endl;
+    }
+}
+
+void runRoutingComparison(int num_stations, unsigned seed) {
+    std::cout << "== " << num_stations << " stations, routing lookups on 3 threads, LinkedList + shared_mutex vs RcuList =="
+              << std::endl;
+    std::vector<KitchenStation*> stations;
+    stations.reserve(num_stations);
+    for (int i = 0; i < num_stations; ++i) {
+        stations.push_back(new KitchenStation("Station " + std::to_string(i)));
+    }
+    for (bool reconfigure : {false, true}) {
+        runRouting<LockedStationList>("LinkedList+shared_mutex", stations, seed, reconfigure);
+        runRouting<RcuStationList>("RcuList", stations, seed, reconfigure);
+    }
+    std::cout << std::endl;
+    for (KitchenStation* station : stations) {
+        delete station;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 42;
+    // 10^6 orders is opt-in (./bench 1000000): the 10^5 scale alone already runs for several minutes
+    std::vector<int> scales = {1000, 10000, 100000};
+    if (argc > 1) {
+        scales = {std::stoi(argv[1])};
+    }
+    OrderTracer::setEnabled(argc > 3);
+    for (int orders : scales) {
+        for (StationManager::StationOrdering ordering : {StationManager::FIXED, StationManager::MOVE_TO_FRONT,
+                                                         StationManager::TRANSPOSE, StationManager::FREQUENCY_COUNT}) {
+            runScale(orders, seed, PER_DISH, ordering);
+        }
+        for (StationManager::StationRouting routing : {StationManager::MOST_SERVINGS, StationManager::LEAST_BUSY}) {
+            runScale(orders, seed, PER_DISH, StationManager::FIXED, routing);
+        }
+        runScale(orders, seed, BATCH_COOKING, StationManager::FIXED);
+        runScale(orders, seed, PLANNED, StationManager::FIXED);
+        // With a short backup stock, failed orders pile up; parking them stops every batch from re-probing them
+        runScale(orders, seed, PER_DISH, StationManager::FIXED, StationManager::FIRST_FIT, 0.5);
+        runScale(orders, seed, PARKED_ORDERS, StationManager::FIXED, StationManager::FIRST_FIT, 0.5);
+        runPipeline(orders, seed, 0);
+        runPipeline(orders, seed, 3);
+    }
+    for (int num_stations : {10000, 30000, 100000}) {
+        runListComparison(num_stations, seed);
+    }
+    for (int num_stations : {64, 1000}) {
+        runRoutingComparison(num_stations, seed);
+    }
+    if (argc > 3 && !OrderTracer::writeChromeTrace(argv[3])) {
+        std::cerr << "Cannot write " << argv[3] << std::endl;
+        return 1;
+    }
+    return 0;
+}
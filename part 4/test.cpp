@@ -0,0 +1,1127 @@
+#include "StationManager.hpp"
+#include "OrderPipeline.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "PlainDish.hpp"
+#include "StationSnapshot.hpp"
+#include "RcuList.hpp"
+#include "UnrolledList.hpp"
+#include "IndexedSkipList.hpp"
+#include "OrderTracer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Dish that is neither an Appetizer, MainCourse nor Dessert; snapshots and the log restore it as a PlainDish
+class ConcreteDish : public Dish {
+public:
+    ConcreteDish(const std::string& name, const std::vector<Ingredient>& ingredients, int prep_time, double price, CuisineType cuisine_type)
+        : Dish(name, ingredients, prep_time, price, cuisine_type) {}
+
+    void display() const override {
+        std::cout << "Dish: " << getName() << " (" << getCuisineType() << ")" << std::endl;
+    }
+
+    void dietaryAccommodations(const DietaryRequest&) override {}
+};
+
+Dish* makeBruschetta() {
+    return new Appetizer("Bruschetta", {{"Bread", 1, 1, 0.5}, {"Tomato", 2, 2, 0.25}}, 10, 7.5, Dish::ITALIAN, Appetizer::BUFFET, 3, true);
+}
+
+Dish* makeSteak() {
+    return new MainCourse("Steak", {{"Beef", 1, 1, 9.0}}, 30, 25.0, Dish::AMERICAN, MainCourse::GRILLED, "Beef",
+                          {{"Fries", MainCourse::STARCHES}, {"Greens", MainCourse::VEGETABLE}}, true);
+}
+
+Dish* makeTart() {
+    return new Dessert("Tart", {{"Flour", 1, 1, 0.75}}, 25, 6.0, Dish::FRENCH, Dessert::SOUR, 4, true);
+}
+
+Dish* makeSoup() {
+    return new ConcreteDish("Soup", {{"Beef", 1, 1, 9.0}}, 15, 8.0, Dish::CHINESE);
+}
+
+// Builds a manager with three stations, stock, backup stock and a queue of every kind of dish
+void buildKitchen(StationManager& manager) {
+    manager.setEventSink(nullptr);
+    KitchenStation* grill = new KitchenStation("Grill Station");
+    grill->assignDishToStation(makeSteak());
+    grill->assignDishToStation(makeSoup());
+    grill->replenishStationIngredients(Ingredient("Beef", 3, 0, 9.0));
+    KitchenStation* cold = new KitchenStation("Cold Station");
+    cold->assignDishToStation(makeBruschetta());
+    cold->replenishStationIngredients(Ingredient("Bread", 2, 0, 0.5));
+    cold->replenishStationIngredients(Ingredient("Tomato", 2, 0, 0.25));
+    KitchenStation* pastry = new KitchenStation("Pastry Station");
+    pastry->assignDishToStation(makeTart());
+    manager.addStation(grill);
+    manager.addStation(cold);
+    manager.addStation(pastry);
+    manager.addBackupIngredients({Ingredient("Beef", 4, 0, 9.0), Ingredient("Flour", 2, 0, 0.75), Ingredient("Tomato", 6, 0, 0.25)});
+    manager.addDishToQueue(makeSteak());
+    manager.addDishToQueue(makeBruschetta());
+    manager.addDishToQueue(makeTart());
+    manager.addDishToQueue(makeSoup());
+}
+
+void describeDish(std::ostringstream& out, const Dish* dish) {
+    out << dish->getName() << " " << dish->getPrepTime() << " " << dish->getPrice() << " " << dish->getCuisineType();
+    for (const Ingredient& ingredient : dish->getIngredients()) {
+        out << " " << ingredient.name << ":" << ingredient.quantity << "/" << ingredient.required_quantity << "@" << ingredient.price;
+    }
+    if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(dish)) {
+        out << " appetizer " << appetizer->getServingStyle() << " " << appetizer->getSpicinessLevel() << " " << appetizer->isVegetarian();
+    } else if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(dish)) {
+        out << " main " << main_course->getCookingMethod() << " " << main_course->getProteinType() << " " << main_course->isGlutenFree();
+        for (const MainCourse::SideDish& side : main_course->getSideDishes()) {
+            out << " " << side.name << ":" << side.category;
+        }
+    } else if (const Dessert* dessert = dynamic_cast<const Dessert*>(dish)) {
+        out << " dessert " << dessert->getFlavorProfile() << " " << dessert->getSweetnessLevel() << " " << dessert->containsNuts();
+    } else {
+        out << " plain";
+    }
+    out << "\n";
+}
+
+// Describes every station, dish, stock, queued dish, backup ingredient and setting a snapshot keeps
+std::string describeKitchen(const StationManager& manager) {
+    std::ostringstream out;
+    out << manager.isBatchCooking() << manager.isReplenishmentPlanning() << manager.getStationOrdering() << manager.getStationRouting() << "\n";
+    for (KitchenStation* station : manager) {
+        out << "station " << station->getName() << "\n";
+        for (Dish* dish : station->getDishes()) {
+            describeDish(out, dish);
+        }
+        for (const Ingredient& ingredient : station->getIngredientsStock()) {
+            out << "stock " << ingredient.name << ":" << ingredient.quantity << "@" << ingredient.price << "\n";
+        }
+    }
+    std::queue<Dish*> queue = manager.getDishQueue();
+    while (!queue.empty()) {
+        out << "queued ";
+        describeDish(out, queue.front());
+        queue.pop();
+    }
+    for (const Ingredient& ingredient : manager.getBackupIngredients()) {
+        out << "backup " << ingredient.name << ":" << ingredient.quantity << "@" << ingredient.price << "\n";
+    }
+    return out.str();
+}
+
+void deleteStations(StationManager& manager) {
+    for (KitchenStation* station : manager) {
+        delete station;
+    }
+}
+
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream bytes;
+    bytes << file.rdbuf();
+    return bytes.str();
+}
+
+void writeFile(const std::string& filename, const std::string& bytes) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << bytes;
+}
+
+void testSnapshotRoundTrip() {
+    const std::string filename = "test_snapshot.bin";
+    StationManager manager;
+    buildKitchen(manager);
+    manager.setStationOrdering(StationManager::MOVE_TO_FRONT);
+    manager.setStationRouting(StationManager::MOST_SERVINGS);
+    manager.setBatchCooking(true);
+    assert(manager.saveSnapshot(filename) && "Saving a snapshot should succeed.");
+
+    StationManager restored;
+    restored.setEventSink(nullptr);
+    assert(restored.restoreSnapshot(filename) && "Restoring a saved snapshot should succeed.");
+    assert(describeKitchen(restored) == describeKitchen(manager) && "The restored kitchen should equal the saved one.");
+    assert(!restored.restoreSnapshot(filename) && "Restoring into a manager with stations should fail.");
+
+    // A dish of another kind keeps its Dish fields and comes back as a PlainDish
+    std::queue<Dish*> queue = restored.getDishQueue();
+    assert(queue.back()->getName() == "Soup" && dynamic_cast<PlainDish*>(queue.back()) != nullptr);
+
+    deleteStations(manager);
+    deleteStations(restored);
+    std::remove(filename.c_str());
+    std::cout << "Test passed: snapshot save and restore.\n";
+}
+
+void testSnapshotRejectsBadEnums() {
+    const std::string filename = "test_snapshot.bin";
+    const std::string corrupt_filename = "test_snapshot_corrupt.bin";
+    StationManager manager;
+    buildKitchen(manager);
+    assert(manager.saveSnapshot(filename));
+    const std::string image = readFile(filename);
+    const SnapshotHeader& header = *reinterpret_cast<const SnapshotHeader*>(image.data());
+
+    // The first dish is the Grill Station's Steak, whose first side dish is Fries
+    const struct {
+        size_t offset;
+        int bad_value;
+    } fields[] = {
+        {offsetof(SnapshotHeader, version), SnapshotBuilder::VERSION + 1},
+        {offsetof(SnapshotHeader, plan_objective), ReplenishmentPlanner::MAXIMIZE_VALUE + 1},
+        {offsetof(SnapshotHeader, station_ordering), StationManager::FREQUENCY_COUNT + 1},
+        {offsetof(SnapshotHeader, station_routing), StationManager::LEAST_BUSY + 1},
+        {header.dishes_offset + offsetof(SnapshotDish, kind), SnapshotDish::PLAIN + 1},
+        {header.dishes_offset + offsetof(SnapshotDish, cuisine_type), Dish::OTHER + 1},
+        {header.dishes_offset + offsetof(SnapshotDish, style), MainCourse::RAW + 1},
+        {header.side_dishes_offset + offsetof(SnapshotSideDish, category), MainCourse::VEGETABLE + 1},
+    };
+    for (const auto& field : fields) {
+        std::string corrupt = image;
+        corrupt[field.offset] = static_cast<char>(field.bad_value);
+        writeFile(corrupt_filename, corrupt);
+        StationManager restored;
+        assert(!restored.restoreSnapshot(corrupt_filename) && "A snapshot with an out-of-range version or enum should be rejected.");
+        assert(restored.isEmpty() && restored.getDishQueue().empty());
+
+        corrupt[field.offset] = static_cast<char>(field.bad_value - 1);
+        writeFile(corrupt_filename, corrupt);
+        StationManager accepted;
+        accepted.setEventSink(nullptr);
+        assert(accepted.restoreSnapshot(corrupt_filename) && "The largest valid value of each field should be accepted.");
+        deleteStations(accepted);
+    }
+
+    // Only the current version is read
+    std::string old_version = image;
+    old_version[offsetof(SnapshotHeader, version)] = static_cast<char>(SnapshotBuilder::VERSION - 1);
+    writeFile(corrupt_filename, old_version);
+    StationManager old_restored;
+    assert(!old_restored.restoreSnapshot(corrupt_filename) && "A snapshot of an older version should be rejected.");
+
+    deleteStations(manager);
+    std::remove(filename.c_str());
+    std::remove(corrupt_filename.c_str());
+    std::cout << "Test passed: snapshots of another version or with out-of-range enums are rejected.\n";
+}
+
+void testRecoveryFromSnapshotAndLog() {
+    const std::string snapshot_filename = "test_recovery.bin";
+    const std::string log_filename = "test_recovery.log";
+    std::remove(log_filename.c_str());
+    std::string before;
+    {
+        StationManager manager;
+        std::shared_ptr<WriteAheadLog> log = std::make_shared<WriteAheadLog>(log_filename);
+        manager.setWriteAheadLog(log);
+        buildKitchen(manager);
+        assert(manager.saveSnapshot(snapshot_filename));
+
+        // Mutations after the snapshot exist only in the log
+        manager.prepareNextDish();
+        manager.addDishToQueue(makeSoup());
+        manager.addDishToQueue(makeBruschetta());
+        manager.processAllDishes();
+        manager.addBackupIngredient(Ingredient("Bread", 2, 0, 0.5));
+        manager.replenishIngredientAtStation("Pastry Station", Ingredient("Flour", 1, 0, 0.75));
+        manager.prepareDishAtStation("Pastry Station", "Tart");
+        manager.addDishToQueue(makeTart());
+        manager.addDishToQueue(makeSoup());
+        manager.prepareNextDish();
+        before = describeKitchen(manager);
+        assert(log->commit());
+        manager.setWriteAheadLog(nullptr);
+        deleteStations(manager);
+    }
+
+    StationManager recovered;
+    recovered.setEventSink(nullptr);
+    assert(recovered.recover(snapshot_filename, log_filename) && "Every logged record should replay.");
+    assert(describeKitchen(recovered) == before && "Recovery should rebuild the kitchen as it was before the crash.");
+
+    deleteStations(recovered);
+    std::remove(snapshot_filename.c_str());
+    std::remove(log_filename.c_str());
+    std::cout << "Test passed: recovery from a snapshot and the log.\n";
+}
+
+void testTornLogTail() {
+    const std::string log_filename = "test_torn.log";
+    std::remove(log_filename.c_str());
+    uint64_t last_sequence = 0;
+    {
+        WriteAheadLog log(log_filename);
+        for (int i = 0; i < 3; ++i) {
+            WalRecord record(WalRecord::BACKUP_ADD);
+            record.ingredient = Ingredient("Beef", i + 1, 0, 9.0);
+            last_sequence = log.append(record);
+        }
+    }
+
+    // A crash in the middle of a write leaves part of a record at the end
+    writeFile(log_filename, readFile(log_filename) + std::string("\x30\0\0\0torn", 8));
+    std::vector<WalRecord> records;
+    assert(WriteAheadLog::readAll(log_filename, records));
+    assert(records.size() == 3 && records.back().sequence == last_sequence && "Reading should stop before the torn record.");
+
+    StationManager recovered;
+    recovered.setEventSink(nullptr);
+    assert(recovered.recover("", log_filename) && "The records before the torn one should replay.");
+    assert(recovered.getBackupQuantity("Beef") == 6);
+
+    // Reopening cuts the torn record off and numbering continues after the last complete record
+    {
+        WriteAheadLog log(log_filename);
+        assert(log.lastSequence() == last_sequence);
+        assert(log.append(WalRecord(WalRecord::BACKUP_CLEAR)) == last_sequence + 1);
+    }
+    records.clear();
+    assert(WriteAheadLog::readAll(log_filename, records));
+    assert(records.size() == 4 && records.back().type == WalRecord::BACKUP_CLEAR);
+
+    std::remove(log_filename.c_str());
+    std::cout << "Test passed: a torn log tail is ignored and cut off.\n";
+}
+
+void testGroupCommit() {
+    const std::string log_filename = "test_group.log";
+    const int record_count = 1000;
+    std::remove(log_filename.c_str());
+    {
+        WriteAheadLog log(log_filename, WriteAheadLog::GROUP_COMMIT);
+        WalRecord record(WalRecord::PREPARE);
+        record.station = "Grill Station";
+        record.dish = "Steak";
+        for (int i = 0; i < record_count; ++i) {
+            log.append(record);
+        }
+        assert(log.commit());
+        assert(log.committedSequence() == log.lastSequence() && log.lastSequence() == uint64_t(record_count));
+        assert(log.getSyncCount() >= 1 && log.getSyncCount() < record_count && "Records should be fsynced in groups.");
+    }
+    std::vector<WalRecord> records;
+    assert(WriteAheadLog::readAll(log_filename, records));
+    assert(records.size() == size_t(record_count) && records.back().dish == "Steak");
+
+    records.clear();
+    assert(WriteAheadLog::readAll(log_filename, records, record_count - 10));
+    assert(records.size() == 10 && records.front().sequence == uint64_t(record_count - 9));
+
+    std::remove(log_filename.c_str());
+    std::cout << "Test passed: group commit.\n";
+}
+
+void testReplayRejectsMismatchedRemoval() {
+    const std::string log_filename = "test_mismatch.log";
+    std::remove(log_filename.c_str());
+    {
+        WriteAheadLog log(log_filename);
+        WalRecord enqueue(WalRecord::ENQUEUE);
+        std::unique_ptr<Dish> soup(makeSoup());
+        enqueue.setDish(*soup);
+        log.append(enqueue);
+
+        // Logged against a queue of two dishes, but replay sees one
+        WalRecord remove(WalRecord::QUEUE_REMOVE);
+        remove.positions = {0};
+        remove.quantity = 2;
+        log.append(remove);
+    }
+
+    StationManager recovered;
+    recovered.setEventSink(nullptr);
+    assert(!recovered.recover("", log_filename) && "A removal that does not match the queue should stop replay.");
+    assert(recovered.getDishQueue().size() == 1 && "The queue should be left as it was before the bad record.");
+
+    std::remove(log_filename.c_str());
+    std::cout << "Test passed: a removal that does not match the queue is rejected.\n";
+}
+
+void testRecoveryAfterMerge() {
+    const std::string snapshot_filename = "test_merge.bin";
+    const std::string log_filename = "test_merge.log";
+    std::remove(log_filename.c_str());
+    std::string before;
+    {
+        StationManager manager;
+        std::shared_ptr<WriteAheadLog> log = std::make_shared<WriteAheadLog>(log_filename);
+        manager.setWriteAheadLog(log);
+        buildKitchen(manager);
+        assert(manager.saveSnapshot(snapshot_filename));
+
+        // The Pastry Station can only prepare Bruschetta with the dish and stock it takes over in the merge
+        assert(manager.mergeStations("Pastry Station", "Cold Station"));
+        assert(manager.prepareDishAtStation("Pastry Station", "Bruschetta"));
+        before = describeKitchen(manager);
+        assert(log->commit());
+        manager.setWriteAheadLog(nullptr);
+        deleteStations(manager);
+    }
+
+    StationManager recovered;
+    recovered.setEventSink(nullptr);
+    assert(recovered.recover(snapshot_filename, log_filename) && "The merge should replay before the prepare that needs it.");
+    assert(describeKitchen(recovered) == before);
+    assert(recovered.findStation("Cold Station") == nullptr);
+
+    deleteStations(recovered);
+    std::remove(snapshot_filename.c_str());
+    std::remove(log_filename.c_str());
+    std::cout << "Test passed: recovery replays a station merge.\n";
+}
+
+void testMetricsSurviveReset() {
+    StationManager manager;
+    buildKitchen(manager);
+    manager.processAllDishes();
+    MetricsSnapshot metrics = manager.getMetricsSnapshot();
+    assert(metrics.stations.size() == 3 && metrics.dishes.size() == 4);
+    assert(metrics.stations[0].name == "Cold Station" && metrics.stations[0].prepared == 1);
+    assert(metrics.stations[1].name == "Grill Station" && metrics.stations[1].prepared == 2);
+    assert(metrics.stations[2].name == "Pastry Station" && metrics.stations[2].replenishments == 1);
+
+    // Reset zeroes the counters in place; the handles resolved when the stations were added still record
+    manager.resetMetrics();
+    metrics = manager.getMetricsSnapshot();
+    assert(metrics.stations.empty() && metrics.dishes.empty() && metrics.queue_high_water == 0);
+    manager.addDishToQueue(makeSteak());
+    manager.processAllDishes();
+    metrics = manager.getMetricsSnapshot();
+    assert(metrics.stations.size() == 1 && metrics.stations[0].name == "Grill Station");
+    assert(metrics.stations[0].attempted == 1 && metrics.stations[0].prepared == 1 && metrics.stations[0].prepare_latency.count == 1);
+    assert(metrics.dishes.size() == 1 && metrics.dishes[0].name == "Steak" && metrics.dishes[0].prepared == 1);
+
+    deleteStations(manager);
+    std::cout << "Test passed: metrics handles survive a reset.\n";
+}
+
+// Builds a manager with one station that carries Steak and holds beef for the given number of servings
+KitchenStation* buildGrill(StationManager& manager, int beef) {
+    manager.setEventSink(nullptr);
+    KitchenStation* grill = new KitchenStation("Grill Station");
+    grill->assignDishToStation(makeSteak());
+    if (beef > 0) {
+        grill->replenishStationIngredients(Ingredient("Beef", beef, 0, 9.0));
+    }
+    manager.addStation(grill);
+    return grill;
+}
+
+void testPipelineCompletesOrders() {
+    const int orders = 200;
+    for (size_t worker_threads : {0, 3}) {
+        StationManager manager;
+        buildGrill(manager, orders);
+        PipelineExecutor executor(worker_threads);
+        OrderPipeline pipeline(manager, executor);
+        std::atomic<int> completions(0);
+        pipeline.setCompletionHandler([&completions](const Dish& dish, const std::string& station_name) {
+            assert(dish.getName() == "Steak" && station_name == "Grill Station");
+            completions++;
+        });
+        for (int i = 0; i < orders; ++i) {
+            pipeline.submit(makeSteak());
+        }
+        // Worker threads start orders as they are posted; without them nothing runs before run()
+        assert(worker_threads > 0 || pipeline.getInFlightCount() == static_cast<size_t>(orders));
+        executor.run();
+        assert(pipeline.getCompletedCount() == orders && completions == orders);
+        assert(pipeline.getInFlightCount() == 0 && pipeline.getWaitingForStockCount() == 0);
+        assert(pipeline.getInFlightHighWater() <= static_cast<size_t>(orders));
+        assert(worker_threads > 0 || pipeline.getInFlightHighWater() == static_cast<size_t>(orders));
+        assert(manager.findStation("Grill Station")->servingsAvailable("Steak") == 0);
+        deleteStations(manager);
+    }
+    std::cout << "Test passed: the order pipeline completes every order with and without worker threads.\n";
+}
+
+void testPipelineWakesParkedOrder() {
+    StationManager manager;
+    buildGrill(manager, 0);
+    PipelineExecutor executor(2);
+    OrderPipeline pipeline(manager, executor);
+    pipeline.submit(makeSteak());
+    executor.run();
+    assert(pipeline.getWaitingForStockCount() == 1 && pipeline.getInFlightCount() == 1 && pipeline.getCompletedCount() == 0);
+
+    // Backup stock the order lacks wakes it, and it replenishes its station from there
+    assert(pipeline.addBackupIngredient(Ingredient("Beef", 1, 0, 9.0)));
+    executor.run();
+    assert(pipeline.getWaitingForStockCount() == 0 && pipeline.getInFlightCount() == 0 && pipeline.getCompletedCount() == 1);
+    assert(manager.getDishQueue().empty());
+    deleteStations(manager);
+    std::cout << "Test passed: the order pipeline wakes an order parked on missing stock.\n";
+}
+
+void testPipelineDrainsParkedOrders() {
+    StationManager manager;
+    buildGrill(manager, 1);
+    {
+        PipelineExecutor executor(1);
+        OrderPipeline pipeline(manager, executor);
+        for (int i = 0; i < 3; ++i) {
+            pipeline.submit(makeSteak());
+        }
+        executor.run();
+        assert(pipeline.getCompletedCount() == 1 && pipeline.getWaitingForStockCount() == 2);
+    }
+    // The pipeline's destructor hands the orders still waiting to the manager's queue
+    std::queue<Dish*> queue = manager.getDishQueue();
+    assert(queue.size() == 2 && queue.front()->getName() == "Steak");
+    manager.clearDishQueue();
+    deleteStations(manager);
+    std::cout << "Test passed: destroying the order pipeline moves parked orders to the manager's queue.\n";
+}
+
+Dish* makeDish(const std::string& name, const std::vector<Ingredient>& ingredients, double price = 5.0) {
+    return new ConcreteDish(name, ingredients, 10, price, Dish::OTHER);
+}
+
+// Lists the names of the queued dishes front to back
+std::vector<std::string> queuedNames(const StationManager& manager) {
+    std::vector<std::string> names;
+    std::queue<Dish*> queue = manager.getDishQueue();
+    while (!queue.empty()) {
+        names.push_back(queue.front()->getName());
+        queue.pop();
+    }
+    return names;
+}
+
+void testBatchCookingCoalescesDishes() {
+    StationManager manager;
+    manager.setEventSink(nullptr);
+    manager.setBatchCooking(true);
+    KitchenStation* grill = new KitchenStation("Grill Station");
+    grill->assignDishToStation(makeDish("Chicken", {{"Chicken", 1, 1, 5.0}}));
+    grill->replenishStationIngredients(Ingredient("Chicken", 3, 0, 5.0));
+    KitchenStation* cold = new KitchenStation("Cold Station");
+    cold->assignDishToStation(makeDish("Salad", {{"Lettuce", 1, 2, 1.0}}));
+    cold->replenishStationIngredients(Ingredient("Lettuce", 2, 0, 1.0));
+    manager.addStation(grill);
+    manager.addStation(cold);
+    manager.addBackupIngredient(Ingredient("Chicken", 2, 0, 5.0));
+    for (int i = 0; i < 6; ++i) {
+        manager.addDishToQueue(makeDish("Chicken", {{"Chicken", 1, 1, 5.0}}));
+        manager.addDishToQueue(makeDish("Salad", {{"Lettuce", 1, 2, 1.0}}));
+    }
+
+    // Twelve orders of two dishes are routed as two batches
+    manager.processAllDishes();
+    assert(manager.getRoutingCount() == 2);
+    // Five chickens fit the station and backup stock together, one salad fits the lettuce
+    assert((queuedNames(manager) == std::vector<std::string>{"Salad", "Salad", "Salad", "Salad", "Chicken", "Salad"}));
+    assert(manager.getBackupIngredients().empty() && grill->getIngredientsStock().empty());
+
+    manager.clearDishQueue();
+    deleteStations(manager);
+    std::cout << "Test passed: batch cooking coalesces identical queued dishes.\n";
+}
+
+void testReplenishForDishIsAllOrNothing() {
+    StationManager manager;
+    manager.setEventSink(nullptr);
+    KitchenStation* oven = new KitchenStation("Oven Station");
+    oven->assignDishToStation(makeDish("Wellington", {{"Beef", 2, 2, 10.0}, {"Pastry", 1, 1, 2.0}}));
+    oven->replenishStationIngredients(Ingredient("Beef", 1, 0, 10.0));
+    manager.addStation(oven);
+    manager.addBackupIngredient(Ingredient("Beef", 2, 0, 10.0));
+
+    // The backup has the beef but no pastry, so nothing moves
+    assert(!manager.replenishForDish("Oven Station", "Wellington"));
+    assert(manager.getBackupQuantity("Beef") == 2);
+    assert(oven->getIngredientsStock().size() == 1 && oven->getIngredientsStock()[0].quantity == 1);
+
+    // With the pastry in backup, only the shortfall moves
+    manager.addBackupIngredient(Ingredient("Pastry", 1, 0, 2.0));
+    assert(manager.replenishForDish("Oven Station", "Wellington"));
+    assert(manager.getBackupQuantity("Beef") == 1 && manager.getBackupQuantity("Pastry") == 0);
+    assert(oven->canCompleteOrder("Wellington"));
+
+    deleteStations(manager);
+    std::cout << "Test passed: replenishForDish moves the whole shortfall or nothing.\n";
+}
+
+void testPlannerAllocatesScarceBackup() {
+    for (ReplenishmentPlanner::Objective objective : {ReplenishmentPlanner::MAXIMIZE_DISHES, ReplenishmentPlanner::MAXIMIZE_VALUE}) {
+        StationManager manager;
+        manager.setEventSink(nullptr);
+        manager.setReplenishmentPlanning(true, objective);
+        KitchenStation* oven = new KitchenStation("Oven Station");
+        oven->assignDishToStation(makeDish("Wellington", {{"Beef", 2, 2, 10.0}}, 30.0));
+        KitchenStation* grill = new KitchenStation("Grill Station");
+        grill->assignDishToStation(makeDish("Steak", {{"Beef", 1, 1, 10.0}}, 10.0));
+        manager.addStation(oven);
+        manager.addStation(grill);
+        manager.addBackupIngredient(Ingredient("Beef", 2, 0, 10.0));
+        // Serving in queue order would spend all the beef on the Wellington
+        manager.addDishToQueue(makeDish("Wellington", {{"Beef", 2, 2, 10.0}}, 30.0));
+        manager.addDishToQueue(makeDish("Steak", {{"Beef", 1, 1, 10.0}}, 10.0));
+        manager.addDishToQueue(makeDish("Steak", {{"Beef", 1, 1, 10.0}}, 10.0));
+
+        ReplenishmentPlan plan = manager.planReplenishment();
+        assert(plan.assignments.size() == 3);
+        if (objective == ReplenishmentPlanner::MAXIMIZE_DISHES) {
+            assert(plan.planned_dishes == 2 && plan.planned_value == 20.0);
+            assert(plan.assignments[0] == nullptr && plan.assignments[1] == grill && plan.assignments[2] == grill);
+        } else {
+            assert(plan.planned_dishes == 1 && plan.planned_value == 30.0);
+            assert(plan.assignments[0] == oven && plan.assignments[1] == nullptr && plan.assignments[2] == nullptr);
+        }
+
+        manager.processAllDishes();
+        std::vector<std::string> left = queuedNames(manager);
+        if (objective == ReplenishmentPlanner::MAXIMIZE_DISHES) {
+            assert((left == std::vector<std::string>{"Wellington"}));
+        } else {
+            assert((left == std::vector<std::string>{"Steak", "Steak"}));
+        }
+        assert(manager.getBackupQuantity("Beef") == 0);
+
+        manager.clearDishQueue();
+        deleteStations(manager);
+    }
+    std::cout << "Test passed: the replenishment planner allocates scarce backup stock by its objective.\n";
+}
+
+// Lists the first letter of every station name in list order
+std::string stationOrder(const StationManager& manager) {
+    std::string order;
+    for (KitchenStation* station : manager) {
+        order += station->getName()[0];
+    }
+    return order;
+}
+
+void testStationOrderingPolicies() {
+    const struct {
+        StationManager::StationOrdering ordering;
+        const char* after_hits[3];
+    } cases[] = {
+        {StationManager::FIXED, {"ABCD", "ABCD", "ABCD"}},
+        {StationManager::MOVE_TO_FRONT, {"DABC", "DABC", "CDAB"}},
+        {StationManager::TRANSPOSE, {"ABDC", "ADBC", "ADCB"}},
+        {StationManager::FREQUENCY_COUNT, {"DABC", "DABC", "DCAB"}},
+    };
+    for (const auto& test_case : cases) {
+        StationManager manager;
+        manager.setEventSink(nullptr);
+        manager.setStationOrdering(test_case.ordering, 1.0);
+        for (const char* name : {"A Station", "B Station", "C Station", "D Station"}) {
+            manager.addStation(new KitchenStation(name));
+        }
+        KitchenStation* pie = manager.findStation("C Station");
+        pie->assignDishToStation(makeDish("Pie", {{"Flour", 1, 1, 1.0}}));
+        pie->replenishStationIngredients(Ingredient("Flour", 5, 0, 1.0));
+        KitchenStation* soup = manager.findStation("D Station");
+        soup->assignDishToStation(makeDish("Soup", {{"Water", 1, 1, 1.0}}));
+        soup->replenishStationIngredients(Ingredient("Water", 5, 0, 1.0));
+
+        // Two soups, then a pie: with FREQUENCY_COUNT the pie station moves up, but not past the soup station
+        const char* dishes[] = {"Soup", "Soup", "Pie"};
+        for (int i = 0; i < 3; ++i) {
+            manager.addDishToQueue(makeDish(dishes[i], {}));
+            if (i == 1) {
+                manager.processAllDishes();
+            } else {
+                assert(manager.prepareNextDish());
+            }
+            assert(manager.getDishQueue().empty());
+            assert(stationOrder(manager) == test_case.after_hits[i]);
+        }
+        deleteStations(manager);
+    }
+    std::cout << "Test passed: the station list reorders by the StationOrdering policy.\n";
+}
+
+// Adds a station that carries Soup with water for the given number of servings
+KitchenStation* addSoupStation(StationManager& manager, const std::string& name, int water) {
+    KitchenStation* station = new KitchenStation(name);
+    station->assignDishToStation(makeDish("Soup", {{"Water", 1, 1, 1.0}}));
+    station->replenishStationIngredients(Ingredient("Water", water, 0, 1.0));
+    manager.addStation(station);
+    return station;
+}
+
+int stockOf(const KitchenStation* station, const std::string& ingredient_name) {
+    for (const Ingredient& ingredient : station->getIngredientsStock()) {
+        if (ingredient.name == ingredient_name) {
+            return ingredient.quantity;
+        }
+    }
+    return 0;
+}
+
+void testStationRoutingPolicies() {
+    {
+        // MOST_SERVINGS skips the first station for the one that can serve more
+        StationManager manager;
+        manager.setEventSink(nullptr);
+        manager.setStationRouting(StationManager::MOST_SERVINGS);
+        KitchenStation* first = addSoupStation(manager, "First Station", 1);
+        KitchenStation* second = addSoupStation(manager, "Second Station", 5);
+        manager.addDishToQueue(makeDish("Soup", {}));
+        assert(manager.prepareNextDish());
+        assert(stockOf(first, "Water") == 1 && stockOf(second, "Water") == 4);
+        for (int i = 0; i < 4; ++i) {
+            manager.addDishToQueue(makeDish("Soup", {}));
+        }
+        // Ties go to the first station in list order
+        manager.processAllDishes();
+        assert(stockOf(first, "Water") == 0 && stockOf(second, "Water") == 1);
+        assert(manager.getStationBusyTime("First Station") == 10 && manager.getStationBusyTime("Second Station") == 40);
+        deleteStations(manager);
+    }
+    {
+        // LEAST_BUSY alternates between two stations with the same stock
+        StationManager manager;
+        manager.setEventSink(nullptr);
+        manager.setStationRouting(StationManager::LEAST_BUSY);
+        KitchenStation* first = addSoupStation(manager, "First Station", 5);
+        KitchenStation* second = addSoupStation(manager, "Second Station", 5);
+        for (int i = 0; i < 4; ++i) {
+            manager.addDishToQueue(makeDish("Soup", {}));
+        }
+        manager.processAllDishes();
+        assert(stockOf(first, "Water") == 3 && stockOf(second, "Water") == 3);
+        assert(manager.getStationBusyTime("First Station") == 20 && manager.getStationBusyTime("Second Station") == 20);
+        deleteStations(manager);
+    }
+    std::cout << "Test passed: dishes route by the StationRouting policy.\n";
+}
+
+void testParkedOrdersWakeOnStock() {
+    KitchenStation* station = new KitchenStation("Soup Station");
+    station->assignDishToStation(makeDish("Soup", {{"Water", 1, 1, 1.0}, {"Salt", 1, 1, 1.0}}));
+    station->assignDishToStation(makeDish("Pie", {{"Flour", 1, 1, 1.0}}));
+    station->replenishStationIngredients(Ingredient("Salt", 5, 0, 1.0));
+    {
+        StationManager manager;
+        manager.setEventSink(nullptr);
+        manager.setOrderParking(true);
+        manager.addStation(station);
+        manager.addDishToQueue(makeDish("Soup", {}));
+        manager.addDishToQueue(makeDish("Pie", {}));
+        manager.addDishToQueue(makeDish("Soup", {}));
+        manager.processAllDishes();
+        assert(manager.getParkedOrderCount() == 3);
+
+        // Parked orders are skipped without probing a station
+        long routings = manager.getRoutingCount();
+        manager.processAllDishes();
+        assert(!manager.prepareNextDish());
+        assert(manager.getRoutingCount() == routings);
+
+        // Only stock of an ingredient an order lacks wakes it
+        manager.addBackupIngredient(Ingredient("Salt", 3, 0, 1.0));
+        assert(manager.getParkedOrderCount() == 3);
+        station->replenishStationIngredients(Ingredient("Flour", 1, 0, 1.0));
+        assert(manager.getParkedOrderCount() == 2 && "The station's stock listener should wake the pie.");
+        manager.processAllDishes();
+        assert((queuedNames(manager) == std::vector<std::string>{"Soup", "Soup"}));
+        station->replenishStationIngredients(Ingredient("Water", 2, 0, 1.0));
+        assert(manager.getParkedOrderCount() == 0);
+        manager.processAllDishes();
+        assert(manager.getDishQueue().empty());
+        manager.removeStation("Soup Station");
+    }
+    // A station that left the manager no longer calls into it
+    station->replenishStationIngredients(Ingredient("Water", 1, 0, 1.0));
+    delete station;
+    std::cout << "Test passed: parked orders wake when stock they lack arrives.\n";
+}
+
+void testTracePrepareSpansCarryOrder() {
+    OrderTracer::clear();
+    OrderTracer::setEnabled(true);
+    for (bool batch_cooking : {false, true}) {
+        StationManager manager;
+        buildKitchen(manager);
+        manager.setBatchCooking(batch_cooking);
+        manager.processAllDishes();
+        assert(manager.prepareDishAtStation("Grill Station", "Steak"));
+        deleteStations(manager);
+    }
+    OrderTracer::setEnabled(false);
+
+    // Every prepare routed from the queue is tied to its order; only the direct prepare has none
+    std::istringstream trace(OrderTracer::chromeTraceJson());
+    int spans = 0;
+    int without_order = 0;
+    for (std::string line; std::getline(trace, line);) {
+        if (line.find("\"name\": \"prepareDish\"") != std::string::npos) {
+            spans++;
+            without_order += line.find("\"order\": \"0x0\"") != std::string::npos;
+        }
+    }
+    assert(spans >= 8 && without_order == 2);
+    OrderTracer::clear();
+    std::cout << "Test passed: prepare trace spans carry the order they serve.\n";
+}
+
+void testReplenishFromBackupChecksFirst() {
+    StationManager manager;
+    KitchenStation* grill = buildGrill(manager, 0);
+    manager.addBackupIngredient(Ingredient("Beef", 3, 0, 9.0));
+
+    for (int quantity : {0, -2, 4}) {
+        assert(!manager.replenishStationIngredientFromBackup("Grill Station", "Beef", quantity));
+    }
+    assert(!manager.replenishStationIngredientFromBackup("Grill Station", "Salt", 1));
+    assert(!manager.replenishStationIngredientFromBackup("Missing Station", "Beef", 1));
+    assert(manager.getBackupQuantity("Beef") == 3 && grill->getIngredientsStock().empty());
+
+    assert(manager.replenishStationIngredientFromBackup("Grill Station", "Beef", 3));
+    assert(manager.getBackupQuantity("Beef") == 0 && stockOf(grill, "Beef") == 3);
+    assert(grill->getIngredientsStock()[0].price == 9.0);
+
+    deleteStations(manager);
+    std::cout << "Test passed: replenishing from backup moves nothing unless the backup covers it.\n";
+}
+
+// Lists the entries front to back, and checks the back links agree
+template<class T, class Allocator>
+std::vector<T> listEntries(const LinkedList<T, Allocator>& list) {
+    std::vector<T> entries;
+    Node<T>* previous = nullptr;
+    for (Node<T>* node = list.getHeadNode(); node != nullptr; node = node->getNext()) {
+        assert(node->getPrevious() == previous && "Every node should link back to the one before it.");
+        entries.push_back(node->getItem());
+        previous = node;
+    }
+    assert(static_cast<int>(entries.size()) == list.getLength());
+    return entries;
+}
+
+// The node at position, walking from the head
+template<class T, class Allocator>
+Node<T>* nodeAt(const LinkedList<T, Allocator>& list, int position) {
+    Node<T>* node = list.getHeadNode();
+    for (int i = 0; i < position; ++i) {
+        node = node->getNext();
+    }
+    return node;
+}
+
+void testListMoveToFrontAndExtract() {
+    LinkedList<int> list;
+    for (int i = 0; i < 5; ++i) {
+        list.push_back(i);
+    }
+    list.moveToFront(nodeAt(list, 3));
+    assert((listEntries(list) == std::vector<int>{3, 0, 1, 2, 4}));
+
+    // Moving the last node updates the tail, so a push_back lands after the new last entry
+    list.moveToFront(nodeAt(list, 4));
+    list.push_back(5);
+    assert((listEntries(list) == std::vector<int>{4, 3, 0, 1, 2, 5}));
+
+    Node<int>* middle = list.extract(nodeAt(list, 2));
+    assert(middle->getItem() == 0 && list.getLength() == 5);
+    assert((listEntries(list) == std::vector<int>{4, 3, 1, 2, 5}));
+    list.reinsert(list.getHeadNode(), middle);
+    assert((listEntries(list) == std::vector<int>{0, 4, 3, 1, 2, 5}));
+
+    Node<int>* last = list.extract(nodeAt(list, 5));
+    Node<int>* first = list.extract(list.getHeadNode());
+    assert((listEntries(list) == std::vector<int>{4, 3, 1, 2}));
+    list.reinsert(nullptr, first);
+    list.reinsert(nodeAt(list, 1), last);
+    assert((listEntries(list) == std::vector<int>{4, 5, 3, 1, 2, 0}));
+    list.push_back(6);
+    assert(list.getEntry(6) == 6);
+    std::cout << "Test passed: LinkedList moveToFront, extract and reinsert.\n";
+}
+
+template<class Allocator>
+void checkSplice() {
+    LinkedList<std::string, Allocator> list;
+    list.push_back("a");
+    list.push_back("d");
+    {
+        LinkedList<std::string, Allocator> middle;
+        middle.push_back("b");
+        middle.push_back("c");
+        list.splice(nodeAt(list, 1), middle);
+        assert(middle.isEmpty() && middle.getHeadNode() == nullptr);
+        middle.push_back("reused");
+        assert(middle.getLength() == 1);
+    }
+    // The spliced nodes outlive the list they came from
+    assert((listEntries(list) == std::vector<std::string>{"a", "b", "c", "d"}));
+
+    LinkedList<std::string, Allocator> tail;
+    tail.push_back("e");
+    list.splice(nullptr, tail);
+    LinkedList<std::string, Allocator> empty;
+    list.splice(list.getHeadNode(), empty);
+    list.push_back("f");
+    assert((listEntries(list) == std::vector<std::string>{"a", "b", "c", "d", "e", "f"}));
+
+    LinkedList<std::string, Allocator> target;
+    target.splice(nullptr, list);
+    assert(list.isEmpty() && target.getLength() == 6 && target.getEntry(5) == "f");
+    target.remove(1);
+    target.clear();
+    assert(target.isEmpty());
+}
+
+void testListSplice() {
+    checkSplice<NodePool<std::string>>();
+    checkSplice<HeapNodeAllocator<std::string>>();
+    std::cout << "Test passed: LinkedList splice.\n";
+}
+
+void testNodePoolReleaseAndAdopt() {
+    // Trivially destructible items: release rewinds the slabs, so the next node reuses the first slot
+    NodePool<int> pool;
+    Node<int>* first = pool.create(1);
+    for (int i = 2; i <= 40; ++i) {
+        pool.create(i);
+    }
+    assert(pool.release() && "A pool of trivially destructible items should release every node at once.");
+    assert(pool.create(7) == first);
+
+    // Items with a destructor have to be destroyed one by one
+    NodePool<std::string> string_pool;
+    Node<std::string>* word = string_pool.create("word");
+    assert(!string_pool.release());
+    string_pool.destroy(word);
+    assert(string_pool.create("again") == word && "A destroyed node should be reused first.");
+
+    // Adopted nodes stay valid after the pool that made them is gone
+    NodePool<int> owner;
+    Node<int>* adopted;
+    {
+        NodePool<int> donor;
+        adopted = donor.create(42);
+        owner.adopt(donor);
+        Node<int>* fresh = donor.create(5);
+        assert(fresh != adopted && "The donor should start over with new slabs.");
+        donor.destroy(fresh);
+    }
+    assert(adopted->getItem() == 42);
+    owner.destroy(adopted);
+    assert(owner.create(43) == adopted && "An adopted node given back is reused by its new pool.");
+    assert(owner.release());
+
+    // A cleared list of trivially destructible items releases its pool and reuses the slots
+    LinkedList<int> list;
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(i);
+    }
+    Node<int>* head = list.getHeadNode();
+    list.clear();
+    list.push_back(100);
+    assert(list.getHeadNode() == head && list.getLength() == 1);
+    std::cout << "Test passed: NodePool release and adopt.\n";
+}
+
+// Lists the entries with the list's iterators, and checks the const iterators agree
+template<class List>
+std::vector<int> iteratedEntries(List& list) {
+    std::vector<int> entries(list.begin(), list.end());
+    const List& const_list = list;
+    assert((std::vector<int>(const_list.begin(), const_list.end()) == entries));
+    assert((std::vector<int>(list.cbegin(), list.cend()) == entries));
+    return entries;
+}
+
+// Applies random inserts, removes and lookups to a list and to a std::vector, including invalid positions,
+// and compares the two after every step; check_structure inspects the list's own invariants
+template<class List, class CheckStructure>
+void checkAgainstVector(unsigned seed, CheckStructure check_structure) {
+    std::mt19937 random(seed);
+    List list;
+    std::vector<int> expected;
+    for (int step = 0; step < 4000; ++step) {
+        int length = static_cast<int>(expected.size());
+        int position = static_cast<int>(random() % (length + 3)) - 1; // -1 to length + 1
+        int value = static_cast<int>(random() % 1000);
+        switch (random() % 8) {
+            case 0: case 1: case 2:
+                assert(list.insert(position, value) == (position >= 0 && position <= length));
+                if (position >= 0 && position <= length) {
+                    expected.insert(expected.begin() + position, value);
+                }
+                break;
+            case 3: case 4:
+                assert(list.remove(position) == (position >= 0 && position < length));
+                if (position >= 0 && position < length) {
+                    expected.erase(expected.begin() + position);
+                }
+                break;
+            case 5:
+                list.push_back(value);
+                expected.push_back(value);
+                break;
+            case 6:
+                list.push_front(value);
+                expected.insert(expected.begin(), value);
+                break;
+            default:
+                try {
+                    int entry = list.getEntry(position);
+                    assert(position >= 0 && position < length && "getEntry should throw for an invalid position.");
+                    assert(entry == expected[position]);
+                } catch (const PrecondViolatedExcep&) {
+                    assert((position < 0 || position >= length) && "getEntry should only throw for an invalid position.");
+                }
+                break;
+        }
+        if (step == 2500) {
+            list.clear();
+            expected.clear();
+        }
+        assert(list.getLength() == static_cast<int>(expected.size()) && list.isEmpty() == expected.empty());
+        if (step % 50 == 0) {
+            assert(iteratedEntries(list) == expected);
+            check_structure(list);
+
+            // A copy is deep, and assignment replaces the whole list
+            List copy(list);
+            copy.push_back(-1);
+            assert(iteratedEntries(list) == expected);
+            List assigned;
+            assigned.push_back(-2);
+            assigned = copy;
+            assert(assigned.getLength() == list.getLength() + 1 && assigned.getEntry(list.getLength()) == -1);
+        }
+    }
+}
+
+void testUnrolledListAgainstVector() {
+    // Small blocks split and merge often
+    auto check_blocks = [](const auto& list) {
+        int total = 0;
+        for (auto* block = list.getHeadNode(); block != nullptr; block = block->getNext()) {
+            assert(block->getCount() >= 1 && "An emptied block should be freed.");
+            total += block->getCount();
+        }
+        assert(total == list.getLength());
+    };
+    for (unsigned seed : {45u, 46u, 47u}) {
+        checkAgainstVector<UnrolledList<int, 4>>(seed, check_blocks);
+        checkAgainstVector<UnrolledList<int>>(seed, check_blocks);
+    }
+    std::cout << "Test passed: UnrolledList matches std::vector under random edits.\n";
+}
+
+void testIndexedSkipListAgainstVector() {
+    // Positional lookups descend the upper levels, so they agree with the level 0 chain only if every width is right
+    auto check_levels = [](const IndexedSkipList<int>& list) {
+        int position = 0;
+        for (IndexedSkipList<int>::SkipNode* node = list.getHeadNode(); node != nullptr; node = node->getNext()) {
+            assert(list.getPointerTo(position) == node);
+            position++;
+        }
+        assert(position == list.getLength() && list.getPointerTo(position) == nullptr);
+    };
+    for (unsigned seed : {45u, 46u, 47u}) {
+        checkAgainstVector<IndexedSkipList<int>>(seed, check_levels);
+    }
+    std::cout << "Test passed: IndexedSkipList matches std::vector under random edits.\n";
+}
+
+void testRcuListReadersDuringWrites() {
+    RcuList<int> list;
+    for (int i = 0; i < 32; ++i) {
+        list.push_back(i);
+    }
+    std::atomic<bool> writing(true);
+    std::atomic<long> snapshots_checked(0);
+
+    // Each reader copies its snapshot, lets the writer run, and checks the snapshot has not changed
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&list, &writing, &snapshots_checked] {
+            while (writing) {
+                RcuList<int>::Snapshot snapshot = list.read();
+                std::vector<int> first(snapshot.begin(), snapshot.end());
+                for (int i = 0; i < 10; ++i) {
+                    std::this_thread::yield();
+                }
+                assert(std::vector<int>(snapshot.begin(), snapshot.end()) == first && "A snapshot should not change while held.");
+                std::sort(first.begin(), first.end());
+                assert(std::adjacent_find(first.begin(), first.end()) == first.end() && "A version should never be seen half written.");
+                snapshots_checked++;
+            }
+        });
+    }
+
+    std::mt19937 random(48);
+    int next_value = 32;
+    for (int i = 0; i < 20000 || snapshots_checked < 1000; ++i) {
+        int length = list.getLength();
+        switch (random() % 3) {
+            case 0:
+                if (length < 64) {
+                    assert(list.insert(static_cast<int>(random() % (length + 1)), next_value++));
+                }
+                break;
+            case 1:
+                if (length > 0) {
+                    assert(list.remove(static_cast<int>(random() % length)));
+                }
+                break;
+            default:
+                if (length > 0) {
+                    int position = static_cast<int>(random() % length);
+                    int entry = list.getEntry(position);
+                    assert(list.moveToFront(position) && list.getEntry(0) == entry);
+                }
+                break;
+        }
+    }
+
+    // With readers still taking new snapshots, every version retired so far is freed
+    list.synchronize();
+    assert(list.getRetiredCount() == 0);
+    writing = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    assert(snapshots_checked > 0);
+    std::cout << "Test passed: RcuList snapshots stay stable while a writer runs.\n";
+}
+
+int main() {
+    testSnapshotRoundTrip();
+    testSnapshotRejectsBadEnums();
+    testRecoveryFromSnapshotAndLog();
+    testTornLogTail();
+    testGroupCommit();
+    testReplayRejectsMismatchedRemoval();
+    testRecoveryAfterMerge();
+    testMetricsSurviveReset();
+    testPipelineCompletesOrders();
+    testPipelineWakesParkedOrder();
+    testPipelineDrainsParkedOrders();
+    testBatchCookingCoalescesDishes();
+    testReplenishForDishIsAllOrNothing();
+    testPlannerAllocatesScarceBackup();
+    testStationOrderingPolicies();
+    testStationRoutingPolicies();
+    testParkedOrdersWakeOnStock();
+    testTracePrepareSpansCarryOrder();
+    testReplenishFromBackupChecksFirst();
+    testListMoveToFrontAndExtract();
+    testListSplice();
+    testNodePoolReleaseAndAdopt();
+    testUnrolledListAgainstVector();
+    testIndexedSkipListAgainstVector();
+    testRcuListReadersDuringWrites();
+    return 0;
+}